@@ -11,18 +11,37 @@
  ******************************************************************************/
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
+#include "esp_attr.h"
 #include "adxl345.h"
 
 
 /******************************************************************************
  *** DEFINES
  ******************************************************************************/
-#define    STOPPER                0                                      
-#define    MEDIAN_FILTER_SIZE     5
+#define    SHADOW_FIRST           REGISTER_THRESH_TAP_ADDR  /* First writable register */
+#define    SHADOW_SIZE            28                        /* 0x1D..0x38 */
+#define    SHADOW_WRITABLE        0x0817BFFFUL              /* 0x1D..0x2A, 0x2C..0x2F, 0x31, 0x38 */
+#define    SHADOW_BIT(reg)        (1UL << ((reg) - SHADOW_FIRST))
+#define    SHADOW(reg)            regShadow[(reg) - SHADOW_FIRST]
+#define    FLUSH_GAP_MAX          2     /* Clean registers rewritten to join two dirty runs */
+#define    SPI_FIFO_FRAME         8     /* DATAX0..FIFO_STATUS, the SPI DMA receives whole words */
 
  /******************************************************************************
  *** VARIABLES
  ******************************************************************************/
+static I2CBUS_device_t *busDevice;
+static spi_device_handle_t spiDevice;       /* Set when the part is on SPI */
+/* Word aligned frames read as SPI_FIFO_FRAME bytes, a 6 byte receive would
+   make the driver allocate a bounce buffer for every queued transaction */
+static DMA_ATTR uint8_t fifoRaw[ADXL345_FIFO_ENTRIES_MAX][SPI_FIFO_FRAME];
+static DMA_ATTR uint8_t spiBurst[ADXL345_SPI_BURST_MAX];
+static spi_transaction_t spiFifoTrans[ADXL345_FIFO_ENTRIES_MAX];
+static I2CBUS_batchRead_t fifoReads[ADXL345_FIFO_ENTRIES_MAX];
+static uint16_t scaleUgLsb = ADXL345_SCALE_UG_LSB;
+/* Writable registers as the part holds them once the dirty ones are flushed */
+static uint8_t regShadow[SHADOW_SIZE];
+static uint32_t shadowDirty;                /* SHADOW_BIT of each changed register */
 
 
 
@@ -55,6 +74,57 @@ static int8_t ADXL345_FIFOInit(ADXL_fifomode_e fifoSelection);
  */
 static int8_t ADXL345_BWInit(ADXL_powerdataratebw_e modeSelection);
 
+/** \brief  ADXL345 register setup shared by the I2C and SPI init
+ * \param[] Nothing
+ * \return Nothing
+ */
+static void ADXL345_Configure(void);
+
+/** \brief  ADXL345 one SPI transaction, header byte in the address phase
+ * \param header R/W and MB bits with the register address
+ * \param tx Transmit data, NULL for a read
+ * \param rx Receive data, NULL for a write
+ * \param len Data size, at most ADXL345_SPI_BURST_MAX
+ * \return SPI driver status
+ */
+static esp_err_t ADXL345_SpiTransfer(uint8_t header, const uint8_t *tx, uint8_t *rx, size_t len);
+
+/** \brief  ADXL345 drain FIFO entries over SPI, one queued 6 byte MB read per
+ *          entry, CS goes high between entries so each one pops
+ * \param entries Entries to read into fifoRaw
+ * \param done Entries read in order before the first failure
+ * \return SPI driver status
+ */
+static esp_err_t ADXL345_SpiReadFifo(size_t entries, size_t *done);
+
+/** \brief  ADXL345 write contiguous registers with one burst
+ * \param reg_addr First register address
+ * \param data Writing data
+ * \param len Writing data size
+ * \return Bus status
+ */
+static esp_err_t adxl_register_burst_write(ADXL_registeraddr_e reg_addr, const uint8_t *data, size_t len);
+
+/** \brief  ADXL345 change a shadow register, dirty when the value differs
+ * \param reg_addr Writable register address
+ * \param data Register value
+ * \return Nothing
+ */
+static void adxl_shadow_set(ADXL_registeraddr_e reg_addr, uint8_t data);
+
+/** \brief  ADXL345 load the shadows from the part, it keeps its settings over
+ *          an MCU reset
+ * \param[] Nothing
+ * \return Bus status
+ */
+static esp_err_t ADXL345_ShadowLoad(void);
+
+/** \brief  ADXL345 interrupt output GPIO ISR
+ * \param arg Task to notify
+ * \return Nothing
+ */
+static void ADXL345_IntIsr(void *arg);
+
 
 
 /******************************************************************************
@@ -63,7 +133,7 @@ static int8_t ADXL345_BWInit(ADXL_powerdataratebw_e modeSelection);
 
 static int8_t ADXL345_ModeInit(ADXL_mode_e modeSelection) {
 
-	ADXL_power_ctl_t modeConfig;
+	ADXL_power_ctl_t modeConfig = { .u8 = 0 };
 	uint8_t flag;
 
 	flag = modeSelection;
@@ -83,15 +153,14 @@ static int8_t ADXL345_ModeInit(ADXL_mode_e modeSelection) {
 		modeConfig.bit.auto_sleep_u1 = 0x01;
 	}
 
-	
-    adxl_register_write(REGISTER_POWER_CTL_ADDR,modeConfig.u8);
+	adxl_shadow_set(REGISTER_POWER_CTL_ADDR, modeConfig.u8);
 
 	return flag;
 }
 
 static int8_t ADXL345_RangeInit(ADXL_range_e rangeSelection) {
 
-	ADXL_dataformat_t rangeConf;
+	ADXL_dataformat_t rangeConf = { .u8 = 0 };
 	uint8_t flag;
 
 	flag = rangeSelection;
@@ -112,13 +181,18 @@ static int8_t ADXL345_RangeInit(ADXL_range_e rangeSelection) {
 		break;
 	}
 	
-     adxl_register_write(REGISTER_DATA_FORMAT_ADDR,rangeConf.u8);
+	adxl_shadow_set(REGISTER_DATA_FORMAT_ADDR, rangeConf.u8);
+
+	/* 10 bit mode doubles the LSB weight with each range step, full resolution
+	   keeps 3.9 mg/LSB on every range */
+	scaleUgLsb = rangeConf.bit.fullres_u1 ? ADXL345_SCALE_UG_LSB
+	                                      : (ADXL345_SCALE_UG_LSB << rangeConf.bit.range_u2);
 	return flag;
 }
 
 static int8_t ADXL345_FIFOInit(ADXL_fifomode_e fifoSelection) {
 
-	ADXL_fifoctl_t fifoConf;
+	ADXL_fifoctl_t fifoConf = { .u8 = 0 };
 	uint8_t flag;
 
 	flag = fifoSelection;
@@ -138,13 +212,13 @@ static int8_t ADXL345_FIFOInit(ADXL_fifomode_e fifoSelection) {
 		fifoConf.bit.fifoMode_u2 = 0x03;
 		break;
 	}
-	adxl_register_write(REGISTER_FIFO_CTL_ADDR, fifoConf.u8);
+	adxl_shadow_set(REGISTER_FIFO_CTL_ADDR, fifoConf.u8);
 	return flag;
 }
 
 static int8_t ADXL345_BWInit(ADXL_powerdataratebw_e modeSelection) {
 
-	ADXL_bw_rate_t bwConfig;
+	ADXL_bw_rate_t bwConfig = { .u8 = SHADOW(REGISTER_BW_RATE_ADDR) };
 	uint8_t flag;
 
 	flag = modeSelection;
@@ -166,11 +240,162 @@ static int8_t ADXL345_BWInit(ADXL_powerdataratebw_e modeSelection) {
 	case DATARATE800_BANDWIDTH400:
 		bwConfig.bit.rate_u4 = 0x0D;
 		break;
+	case DATARATE1600_BANDWIDTH800:
+		bwConfig.bit.rate_u4 = 0x0E;
+		break;
+	case DATARATE3200_BANDWIDTH1600:
+		bwConfig.bit.rate_u4 = 0x0F;
+		break;
 	}
-	adxl_register_write(REGISTER_BW_RATE_ADDR,bwConfig.u8);
+	adxl_shadow_set(REGISTER_BW_RATE_ADDR, bwConfig.u8);
 	return flag;
 }
 
+static void ADXL345_Configure(void) {
+
+	ADXL345_ShadowLoad();
+	ADXL345_ModeInit(ADXL_MEASURE);
+	ADXL345_RangeInit(RANGE_4G);
+	ADXL345_FIFOInit(FIFO_STREAM); // always new data
+	ADXL345_BWInit(DATARATE400_BANDWIDTH200);
+	ADXL345_Flush();
+}
+
+static esp_err_t ADXL345_SpiTransfer(uint8_t header, const uint8_t *tx, uint8_t *rx, size_t len) {
+
+	spi_transaction_t trans = {
+		.addr   = header,
+		.length = len * 8,
+	};
+	esp_err_t status;
+
+	if(len > ADXL345_SPI_BURST_MAX){
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	/* Up to 4 bytes travel in the descriptor, longer bursts through the DMA buffer */
+	if(len <= sizeof(trans.tx_data)){
+		trans.flags = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA;
+		if(tx != NULL){
+			memcpy(trans.tx_data, tx, len);
+		}
+	}else
+	{
+		memset(spiBurst, 0, len);
+		if(tx != NULL){
+			memcpy(spiBurst, tx, len);
+		}
+		trans.tx_buffer = spiBurst;
+		trans.rx_buffer = spiBurst;
+	}
+
+	status = spi_device_polling_transmit(spiDevice, &trans);
+
+	if(status == ESP_OK && rx != NULL){
+		memcpy(rx, (len <= sizeof(trans.rx_data)) ? trans.rx_data : spiBurst, len);
+	}
+
+	return status;
+}
+
+static esp_err_t ADXL345_SpiReadFifo(size_t entries, size_t *done) {
+
+	spi_transaction_t *result;
+	esp_err_t status = ESP_OK;
+	esp_err_t err;
+	size_t queued;
+	size_t i;
+
+	*done = 0;
+
+	/* The driver turnaround between queued transactions exceeds the 5 us the
+	   FIFO needs after CS rises before the next entry can be read */
+	for(queued = 0; queued < entries; queued++){
+		memset(&spiFifoTrans[queued], 0, sizeof(spiFifoTrans[queued]));
+		spiFifoTrans[queued].addr      = ADXL345_SPI_READ | ADXL345_SPI_MB | REGISTER_DATAX0_ADDR;
+		spiFifoTrans[queued].length    = SPI_FIFO_FRAME * 8;
+		spiFifoTrans[queued].rx_buffer = fifoRaw[queued];
+
+		status = spi_device_queue_trans(spiDevice, &spiFifoTrans[queued], pdMS_TO_TICKS(ADXL345_SPI_TIMEOUT_MS));
+		if(status != ESP_OK){
+			break;
+		}
+	}
+
+	/* Collect every queued result so none is left for the next drain */
+	for(i = 0; i < queued; i++){
+		err = spi_device_get_trans_result(spiDevice, &result, pdMS_TO_TICKS(ADXL345_SPI_TIMEOUT_MS));
+		if(err != ESP_OK){
+			if(status == ESP_OK){
+				status = err;
+			}
+			break;
+		}
+		if(status == ESP_OK){
+			*done = i + 1;
+		}
+	}
+
+	return status;
+}
+
+static esp_err_t adxl_register_burst_write(ADXL_registeraddr_e reg_addr, const uint8_t *data, size_t len) {
+
+	if(spiDevice != NULL){
+		return ADXL345_SpiTransfer(ADXL345_SPI_MB | reg_addr, data, NULL, len);
+	}
+
+	return I2CBUS_BurstWrite(busDevice, reg_addr, data, len);
+}
+
+static void adxl_shadow_set(ADXL_registeraddr_e reg_addr, uint8_t data) {
+
+	if(SHADOW(reg_addr) != data){
+		SHADOW(reg_addr) = data;
+		shadowDirty |= SHADOW_BIT(reg_addr);
+	}
+}
+
+static esp_err_t ADXL345_ShadowLoad(void) {
+
+	size_t burstMax = (spiDevice != NULL) ? ADXL345_SPI_BURST_MAX : SHADOW_SIZE;
+	size_t last;
+	esp_err_t status = ESP_OK;
+
+	/* Writable runs only, reading INT_SOURCE clears events and reading DATAX0..DATAZ1
+	   pops a FIFO entry */
+	for(size_t i = 0; i < SHADOW_SIZE && status == ESP_OK; i = last + 1){
+		last = i;
+		if((SHADOW_WRITABLE & (1UL << i)) == 0){
+			continue;
+		}
+		while(last + 1 < SHADOW_SIZE && (SHADOW_WRITABLE & (1UL << (last + 1))) != 0 && last + 1 - i < burstMax){
+			last++;
+		}
+		status = adxl_register_read(SHADOW_FIRST + i, &regShadow[i], last - i + 1);
+	}
+
+	/* Unknown register state, start from the power-on values and write them all */
+	if(status == ESP_OK){
+		shadowDirty = 0;
+	}else
+	{
+		memset(regShadow, 0, sizeof(regShadow));
+		SHADOW(REGISTER_BW_RATE_ADDR) = 0x0A;
+		shadowDirty = SHADOW_WRITABLE;
+	}
+
+	return status;
+}
+
+static void IRAM_ATTR ADXL345_IntIsr(void *arg) {
+
+	BaseType_t woken = pdFALSE;
+
+	vTaskNotifyGiveFromISR((TaskHandle_t)arg, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
 
 
 
@@ -178,140 +403,382 @@ static int8_t ADXL345_BWInit(ADXL_powerdataratebw_e modeSelection) {
 *** GLOBAL FUNCTIONS
 ******************************************************************************/
 
-void ADXL345_Init(void) {
+esp_err_t adxl_register_read(ADXL_registeraddr_e reg_addr, uint8_t *data, size_t len){
 
-	ADXL345_ModeInit(ADXL_MEASURE);
-	ADXL345_RangeInit(RANGE_4G);
-	ADXL345_FIFOInit(FIFO_STREAM); // always new data
-	ADXL345_BWInit(DATARATE400_BANDWIDTH200);
+	if(spiDevice != NULL){
+		return ADXL345_SpiTransfer(ADXL345_SPI_READ | ((len > 1) ? ADXL345_SPI_MB : 0) | reg_addr, NULL, data, len);
+	}
+
+	return I2CBUS_BurstRead(busDevice, reg_addr, data, len);
 }
 
-int16_t ADXL345_XaxisCalculate(void){
-     uint16_t xaxis;
-     uint8_t xraw_0;
-     uint8_t xraw_1;
-     
+esp_err_t adxl_register_write(ADXL_registeraddr_e reg_addr, uint8_t data){
+
+	esp_err_t status;
+
+	if(spiDevice != NULL){
+		status = ADXL345_SpiTransfer(reg_addr, &data, NULL, sizeof(data));
+	}else
+	{
+		status = I2CBUS_Write(busDevice, reg_addr, data);
+	}
+
+	/* Direct writes keep the shadow in step */
+	if(status == ESP_OK && reg_addr >= SHADOW_FIRST && reg_addr < SHADOW_FIRST + SHADOW_SIZE &&
+	   (SHADOW_WRITABLE & SHADOW_BIT(reg_addr)) != 0){
+		SHADOW(reg_addr) = data;
+		shadowDirty &= ~SHADOW_BIT(reg_addr);
+	}
 
-     adxl_register_read(REGISTER_DATAX0_ADDR, &xraw_0,sizeof(xraw_0));
-     adxl_register_read(REGISTER_DATAX1_ADDR, &xraw_1,sizeof(xraw_1));
+	return status;
+}
 
-     xaxis = (xraw_1 << 8) | xraw_0;
+esp_err_t ADXL345_Flush(void) {
+
+	size_t burstMax = (spiDevice != NULL) ? ADXL345_SPI_BURST_MAX : SHADOW_SIZE;
+	size_t first;
+	size_t last;
+	esp_err_t status = ESP_OK;
+
+	for(size_t i = 0; i < SHADOW_SIZE && shadowDirty != 0 && status == ESP_OK; i = last + 1){
+		first = i;
+		last  = i;
+		if((shadowDirty & (1UL << i)) == 0){
+			continue;
+		}
+
+		/* Grow the burst over writable registers, a short clean gap is cheaper
+		   to rewrite from the shadow than a second transaction */
+		for(size_t j = i + 1; j < SHADOW_SIZE && (SHADOW_WRITABLE & (1UL << j)) != 0 && j - first < burstMax; j++){
+			if(shadowDirty & (1UL << j)){
+				last = j;
+			}else if(j - last > FLUSH_GAP_MAX){
+				break;
+			}
+		}
+
+		status = adxl_register_burst_write(SHADOW_FIRST + first, &regShadow[first], last - first + 1);
+
+		if(status == ESP_OK){
+			shadowDirty &= ~(((1UL << (last - first + 1)) - 1) << first);
+		}
+	}
 
-     return xaxis;
+	return status;
 }
 
-int16_t ADXL345_YaxisCalculate(void){
-     uint16_t yaxis;
-     uint8_t yraw_0;
-     uint8_t yraw_1;
+void ADXL345_Init(I2CBUS_device_t *dev) {
+
+	busDevice = dev;
+
+	ADXL345_Configure();
+}
+
+esp_err_t ADXL345_InitSpi(const ADXL_spiConfig_t *config) {
+
+	spi_bus_config_t busConf = {
+		.mosi_io_num     = config->mosiIo,
+		.miso_io_num     = config->misoIo,
+		.sclk_io_num     = config->sclkIo,
+		.quadwp_io_num   = -1,
+		.quadhd_io_num   = -1,
+		.max_transfer_sz = ADXL345_SPI_BURST_MAX,
+	};
+	spi_device_interface_config_t devConf = {
+		.address_bits   = 8,                     /* Header byte */
+		.mode           = ADXL345_SPI_MODE,
+		.clock_speed_hz = (config->clkSpeed > ADXL345_SPI_CLK_MAX) ? ADXL345_SPI_CLK_MAX : config->clkSpeed,
+		.spics_io_num   = config->csIo,
+		.queue_size     = ADXL345_FIFO_ENTRIES_MAX,
+	};
+	uint8_t devId = 0;
+	esp_err_t status;
+
+	status = spi_bus_initialize(config->host, &busConf, SPI_DMA_CH_AUTO);
+	/* Already initialized for another device on the same host */
+	if(status == ESP_ERR_INVALID_STATE){
+		status = ESP_OK;
+	}
+	if(status == ESP_OK){
+		status = spi_bus_add_device(config->host, &devConf, &spiDevice);
+	}
+	if(status != ESP_OK){
+		spiDevice = NULL;
+		return status;
+	}
+
+	/* SPI has no acknowledge, an absent part reads as 0xFF */
+	status = adxl_register_read(REGISTER_DEVID_ADDR, &devId, sizeof(devId));
+	if(status == ESP_OK && devId != ADXL345_DEVID){
+		status = ESP_ERR_NOT_FOUND;
+	}
+	if(status == ESP_OK){
+		ADXL345_Configure();
+	}
+
+	return status;
+}
 
-     adxl_register_read(REGISTER_DATAY0_ADDR,&yraw_0,sizeof(yraw_0));
-     adxl_register_read(REGISTER_DATAY1_ADDR,&yraw_1,sizeof(yraw_1));
+esp_err_t ADXL345_SetDataRate(ADXL_powerdataratebw_e rate) {
 
-     yaxis = (yraw_1 << 8) | yraw_0;
+	ADXL_bw_rate_t bwConfig = { .u8 = SHADOW(REGISTER_BW_RATE_ADDR) };
 
-     return yaxis;
+	/* Enumeration values are the BW_RATE rate codes */
+	bwConfig.bit.rate_u4 = rate;
+	adxl_shadow_set(REGISTER_BW_RATE_ADDR, bwConfig.u8);
+
+	return ADXL345_Flush();
+}
+
+int16_t ADXL345_XaxisCalculate(void){
+	uint8_t raw[ADXL345_AXIS_READ_SIZE] = { 0 };
+
+	adxl_register_read(REGISTER_DATAX0_ADDR, raw, sizeof(raw));
+
+	return ADXL345_DecodeAxis(raw);
+}
+
+int16_t ADXL345_YaxisCalculate(void){
+	uint8_t raw[ADXL345_AXIS_READ_SIZE] = { 0 };
+
+	adxl_register_read(REGISTER_DATAY0_ADDR, raw, sizeof(raw));
+
+	return ADXL345_DecodeAxis(raw);
 }
 
 int16_t ADXL345_ZaxisCalculate(void){
-     int16_t zaxis;
-     uint8_t zraw_0;
-     uint8_t zraw_1;
-
-     adxl_register_read(REGISTER_DATAZ0_ADDR,&zraw_0,sizeof(zraw_0));
-     adxl_register_read(REGISTER_DATAZ1_ADDR,&zraw_1,sizeof(zraw_1));
-
-     zaxis = (zraw_1 << 8) | zraw_0;
-
-     return zaxis;
-}
-
-uint16_t adxl_median_filter(uint16_t adxlData){
-	struct pair
- {
-   struct pair *point;                              /* Bağlı liste içinde sıralı düzen oluşturan pointerlar */
-   uint16_t     value;                                   /* Values to sort */
- };
- static struct pair buffer[MEDIAN_FILTER_SIZE] = {0}; /* Buffer of nwidth pairs */
- static struct pair *datpoint = buffer;               /* Pointer into circular buffer of data */
- static struct pair small = {NULL, STOPPER};          /* Chain stopper */
- static struct pair big = {&small, 0};                /* Pointer to head (largest) of linked list.*/
-
- struct pair *successor;                              /* Pointer to successor of replaced data item */
- struct pair *scan;                                   /* Pointer used to scan down the sorted list */
- struct pair *scanold;                                /* Previous value of scan */
- struct pair *median;                                 /* Pointer to median */
- uint16_t i;
-
- if (adxlData == STOPPER)
- {
-   adxlData = STOPPER + 1;                             
- }
-
- if ( (++datpoint - buffer) >= MEDIAN_FILTER_SIZE)
- {
-   datpoint = buffer;                               
- }
-
- datpoint->value = adxlData;                          
- successor = datpoint->point;                       
- median = &big;                                     
- scanold = NULL;                                  
- scan = &big;                                       
-
- /* Handle chain-out of first item in chain as special case */
- if (scan->point == datpoint)
- {
-   scan->point = successor;
- }
- scanold = scan;                                     
- scan = scan->point ;                                
-
- /* Loop through the chain, normal loop exit via break. */
- for (i = 0 ; i < MEDIAN_FILTER_SIZE; ++i)
- {
-   /* Handle odd-numbered item in chain  */
-   if (scan->point == datpoint)
-   {
-     scan->point = successor;                      
-   }
-
-   if (scan->value < adxlData)                        
-   {
-     datpoint->point = scanold->point;             
-     scanold->point = datpoint;                    
-     adxlData = STOPPER;
-   };
-
-   /* Step median pointer down chain after doing odd-numbered element */
-   median = median->point;                       
-   if (scan == &small)
-   {
-     break;                                     
-   }
-   scanold = scan;                               
-   scan = scan->point;                           
-
-   /* Handle even-numbered item in chain.  */
-   if (scan->point == datpoint)
-   {
-     scan->point = successor;
-   }
-
-   if (scan->value < adxlData)
-   {
-     datpoint->point = scanold->point;
-     scanold->point = datpoint;
-     adxlData = STOPPER;
-   }
-
-   if (scan == &small)
-   {
-     break;
-   }
-
-   scanold = scan;
-   scan = scan->point;
- }
- return median->value;
+	uint8_t raw[ADXL345_AXIS_READ_SIZE] = { 0 };
+
+	adxl_register_read(REGISTER_DATAZ0_ADDR, raw, sizeof(raw));
+
+	return ADXL345_DecodeAxis(raw);
+}
+
+int16_t ADXL345_DecodeAxis(const uint8_t *raw){
+
+	return (int16_t)(((uint16_t)raw[1] << 8) | raw[0]);
+}
+
+void ADXL345_DecodeFrame(const uint8_t *raw, ADXL_sample_t *sample){
+
+	sample->x_s16 = ADXL345_DecodeAxis(&raw[0]);
+	sample->y_s16 = ADXL345_DecodeAxis(&raw[2]);
+	sample->z_s16 = ADXL345_DecodeAxis(&raw[4]);
+}
+
+void ADXL345_ScaleFrame(const ADXL_sample_t *sample, ADXL_accel_t *accel){
+
+	accel->x_mg_s16 = (int16_t)(((int32_t)sample->x_s16 * scaleUgLsb) / 1000);
+	accel->y_mg_s16 = (int16_t)(((int32_t)sample->y_s16 * scaleUgLsb) / 1000);
+	accel->z_mg_s16 = (int16_t)(((int32_t)sample->z_s16 * scaleUgLsb) / 1000);
+}
+
+esp_err_t ADXL345_CalculateData(ADXL_accel_t *accel){
+
+	uint8_t frame[ADXL345_FRAME_SIZE];
+	ADXL_sample_t sample;
+	esp_err_t status;
+
+	status = adxl_register_read(REGISTER_DATAX0_ADDR, frame, sizeof(frame));
+
+	if(status == ESP_OK){
+		ADXL345_DecodeFrame(frame, &sample);
+		ADXL345_ScaleFrame(&sample, accel);
+	}
+
+	return status;
+}
+
+esp_err_t ADXL345_SetWatermark(uint8_t samples){
+
+	ADXL_fifoctl_t fifoConf = { .u8 = SHADOW(REGISTER_FIFO_CTL_ADDR) };
+
+	fifoConf.bit.samples_u5 = samples;
+	adxl_shadow_set(REGISTER_FIFO_CTL_ADDR, fifoConf.u8);
+
+	return ADXL345_Flush();
+}
+
+esp_err_t ADXL345_ReadFifo(ADXL_sample_t *block, size_t maxSamples, size_t *count){
+
+	ADXL_fifostatus_t fifoStatus;
+	esp_err_t status;
+	size_t entries;
+	size_t i;
+
+	*count = 0;
+
+	status = adxl_register_read(REGISTER_FIFO_STATUS_ADDR, &fifoStatus.u8, sizeof(fifoStatus.u8));
+
+	if(status != ESP_OK){
+		return status;
+	}
+
+	entries = fifoStatus.bit.entries_u6;
+
+	if(entries > maxSamples){
+		entries = maxSamples;
+	}
+	if(entries > ADXL345_FIFO_ENTRIES_MAX){
+		entries = ADXL345_FIFO_ENTRIES_MAX;
+	}
+	if(entries == 0){
+		return ESP_OK;
+	}
+
+	if(spiDevice != NULL){
+		status = ADXL345_SpiReadFifo(entries, &i);
+		entries = i;
+	}else
+	{
+		/* Each entry pops when its 6 byte burst ends, the repeated start gives the
+		   5 us gap the part needs before the next entry */
+		for(i = 0; i < entries; i++){
+			fifoReads[i].dev  = busDevice;
+			fifoReads[i].reg  = REGISTER_DATAX0_ADDR;
+			fifoReads[i].data = fifoRaw[i];
+			fifoReads[i].len  = ADXL345_FRAME_SIZE;
+		}
+
+		status = I2CBUS_ChainRead(fifoReads, entries);
+	}
+
+	/* A failed drain may have popped entries it did not return, the block would
+	   not be contiguous with the next one */
+	if(status != ESP_OK){
+		return status;
+	}
+
+	for(i = 0; i < entries; i++){
+		ADXL345_DecodeFrame(fifoRaw[i], &block[i]);
+	}
+	*count = entries;
+
+	return status;
+}
+
+esp_err_t ADXL345_ConfigInterrupts(ADXL_intenable_t enable, ADXL_intmap_t map){
+
+	esp_err_t status;
+
+	/* Sources are routed before they are enabled, an unchanged map costs nothing */
+	adxl_shadow_set(REGISTER_INT_MAP_ADDR, map.u8);
+	status = ADXL345_Flush();
+
+	if(status == ESP_OK){
+		adxl_shadow_set(REGISTER_INT_ENABLE_ADDR, enable.u8);
+		status = ADXL345_Flush();
+	}
+
+	return status;
+}
+
+esp_err_t ADXL345_AttachInterrupt(gpio_num_t gpio, TaskHandle_t task){
+
+	esp_err_t status;
+	gpio_config_t ioConf = {
+		.pin_bit_mask = 1ULL << gpio,
+		.mode         = GPIO_MODE_INPUT,
+		.pull_up_en   = GPIO_PULLUP_DISABLE,
+		.pull_down_en = GPIO_PULLDOWN_ENABLE,   /* INT outputs are push-pull, active high */
+		.intr_type    = GPIO_INTR_POSEDGE,
+	};
+
+	status = gpio_config(&ioConf);
+
+	if(status == ESP_OK){
+		status = gpio_install_isr_service(0);
+		/* Already installed by another driver */
+		if(status == ESP_ERR_INVALID_STATE){
+			status = ESP_OK;
+		}
+	}
+
+	if(status == ESP_OK){
+		status = gpio_isr_handler_add(gpio, ADXL345_IntIsr, task);
+	}
+
+	return status;
+}
+
+esp_err_t ADXL345_ConfigMotion(const ADXL_motionConfig_t *config){
+
+	ADXL_power_ctl_t powerConf = { .u8 = SHADOW(REGISTER_POWER_CTL_ADDR) };
+	esp_err_t status;
+
+	adxl_shadow_set(REGISTER_THRESH_ACT_ADDR, config->actThresh_u8);
+	adxl_shadow_set(REGISTER_THRESH_INACT_ADDR, config->inactThresh_u8);
+	adxl_shadow_set(REGISTER_TIME_INACT_ADDR, config->inactTime_u8);
+	adxl_shadow_set(REGISTER_ACT_INACT_CTL_ADDR, config->ctl.u8);
+
+	/* Link and auto sleep change in standby, then measurement restarts with
+	   the part awake */
+	powerConf.bit.measure_u1    = 0;
+	powerConf.bit.sleep_u1      = 0;
+	powerConf.bit.link_u1       = config->autoSleep_u1;
+	powerConf.bit.auto_sleep_u1 = config->autoSleep_u1;
+	powerConf.bit.wakeup_u2     = config->wakeup_u2;
+	adxl_shadow_set(REGISTER_POWER_CTL_ADDR, powerConf.u8);
+
+	status = ADXL345_Flush();
+
+	if(status == ESP_OK){
+		powerConf.bit.measure_u1 = 1;
+		adxl_shadow_set(REGISTER_POWER_CTL_ADDR, powerConf.u8);
+		status = ADXL345_Flush();
+	}
+
+	return status;
+}
+
+esp_err_t ADXL345_ConfigTap(const ADXL_tapConfig_t *config){
+
+	adxl_shadow_set(REGISTER_THRESH_TAP_ADDR, config->thresh_u8);
+	adxl_shadow_set(REGISTER_DUR_ADDR, config->dur_u8);
+	adxl_shadow_set(REGISTER_LATENT_ADDR, config->latent_u8);
+	adxl_shadow_set(REGISTER_WINDOW_ADDR, config->window_u8);
+	adxl_shadow_set(REGISTER_TAP_AXES, config->axes.u8);
+
+	return ADXL345_Flush();
+}
+
+esp_err_t ADXL345_ConfigFreeFall(const ADXL_freefallConfig_t *config){
+
+	adxl_shadow_set(REGISTER_THRESH_FF_ADDR, config->thresh_u8);
+	adxl_shadow_set(REGISTER_TIME_FF_ADDR, config->time_u8);
+
+	return ADXL345_Flush();
+}
+
+esp_err_t ADXL345_ReadActTapStatus(ADXL_acttap_status_t *status){
+
+	return adxl_register_read(REGISTER_ACT_TAP_STATUS_ADDR, &status->u8, sizeof(status->u8));
+}
+
+esp_err_t ADXL345_Service(ADXL_sample_t *block, size_t maxSamples, size_t *count, ADXL_intsource_t *source){
+
+	uint8_t frame[ADXL345_FRAME_SIZE];
+	esp_err_t status;
+
+	*count = 0;
+
+	status = adxl_register_read(REGISTER_INT_SOURCE_ADDR, &source->u8, sizeof(source->u8));
+
+	if(status != ESP_OK){
+		return status;
+	}
+
+	/* The output stays asserted until the FIFO is below the watermark, drain it
+	   completely so the next watermark gives a new edge */
+	if(source->bit.watermark || source->bit.overrun_u1){
+		status = ADXL345_ReadFifo(block, maxSamples, count);
+	}else if(source->bit.dataReady_u1 && maxSamples != 0){
+		status = adxl_register_read(REGISTER_DATAX0_ADDR, frame, sizeof(frame));
+		if(status == ESP_OK){
+			ADXL345_DecodeFrame(frame, &block[0]);
+			*count = 1;
+		}
+	}
+
+	return status;
 }
\ No newline at end of file
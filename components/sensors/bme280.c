@@ -12,454 +12,142 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "bme280.h"
-
-/******************************************************************************
- *** DEFINES
- ******************************************************************************/
-#define    STOPPER                0                                      
-#define    MEDIAN_FILTER_SIZE     5
+#include "bmx280.h"
 
 /******************************************************************************
  *** VARIABLES
  ******************************************************************************/
-BME280_registerCtrl_meas_t ctrl_measConf;
-BME280_registerConfig_t configReg;
-uint16_t dig_T1;
-int16_t dig_T2;
-int16_t dig_T3;  
-int32_t t_fine;
-int32_t rawTemp;
-
-
-/******************************************************************************
- *** FUNCTION PROTOTYPES
- ******************************************************************************/
-
-/** \brief  BME280 operating mode initialize function
- * \param modeStatus Operating mode selection
- * \return Nothing
- */
-static void BME280_ModeInit(BME280_modestatus_e modeStatus);
-
-/** \brief  BME280 humadity oversampling initialize function
- * \param humOver Humadity oversampling selection
- * \return Humadity Oversampling status
- */
-static int16_t BME280_HumadityOverSamp(BME280_hum_oversampling_e humOver);
-
-/** \brief  BME280 pressure oversampling initialize function
- * \param pressOver Pressure oversampling selection
- * \return Pressure Oversampling status
- */
-static int16_t BME280_PressOverSamp(BME280_press_oversampling_e pressOver);
-
-/** \brief  BME280 temperature oversampling initialize function
- * \param tempOver Temperature oversampling selection
- * \return Temperature Oversampling status
- */
-static int16_t BME280_TempOverSamp(BME280_temp_oversampling_e tempOver);
-
-/** \brief  BME280 internal IIR filter initialize function
- * \param filterStatus Filter mode selection
- * \return 
- */
-static int16_t BME280_FilterInit(BME280_filtermode_e filterStatus);
-
-/** \brief  BME280 controls inactive duration tstandby in normal mode
- * \param standbyStatus StandBy value selection
- * \return 
- */
-static int16_t BME280_StandByInit(BME280_standbymode_e standbyStatus);
-
-/** \brief  BME280 sensor read the trimming parameters
- * \param[] Nothing
- * \return 
- */
-
-void BME280_ReadTrimmingTemperature(void);
-
-/** \brief  BME280 sensor read and compensation
- * \param adc_T Raw temperature data
- * \return T Final data
- */
-
-int32_t BME280_compensate_T_int32(int32_t adc_T);
-
+/* Single-sensor API on one BMx280 core context, more sensors use bmx280.h */
+static BMX280_t bme280Ctx;
+static const BMX280_config_t bme280Config = {
+     .mode      = BME280_NORMAL_MODE,
+     .tempOver  = TEMP_OVERSAMPLING_X2,
+     .pressOver = PRESS_OVERSAMPLING_X16,
+     .humOver   = HUM_OVERSAMPLING_X1,
+     .filter    = BME280_FILTER_X16,
+     .standby   = BME280_STANDBY_5,
+};
 
 
 /******************************************************************************
- *** LOCAL FUNCTIONS
+ *** GLOBAL FUNCTIONS
  ******************************************************************************/
 
-static int16_t BME280_HumadityOverSamp(BME280_hum_oversampling_e humOver){
-     
-     uint16_t rx_flag;
-     uint8_t flag;
+esp_err_t bme280_register_write(BME280_registerAddr_e reg_addr, uint8_t data){
 
-     flag = humOver;
+     return I2CBUS_Write(bme280Ctx.dev, reg_addr, data);
+}
 
-    BME280_registerctrlhum_t humaditySample;
-     
-     switch (flag)
-     {
-     case HUM_OVERSAMPLING_X1:
-          humaditySample.bit.osrs_h_u3 = 0x01;
-          break;
-     case HUM_OVERSAMPLING_X2:
-          humaditySample.bit.osrs_h_u3 = 0x02;
-          break;
-     case HUM_OVERSAMPLING_X4:
-          humaditySample.bit.osrs_h_u3 = 0x03;
-          break;
-     case HUM_OVERSAMPLING_X8:
-          humaditySample.bit.osrs_h_u3 = 0x04;
-          break;
-     case HUM_OVERSAMPLING_X16:
-          humaditySample.bit.osrs_h_u3 = 0x05;
-          break;
-     }
+esp_err_t bme280_register_read(BME280_registerAddr_e reg_addr, uint8_t *data, size_t len){
 
-     bme280_register_write(REGISTER_CTRL_HUM_ADDR, humaditySample.u8);
+     return I2CBUS_BurstRead(bme280Ctx.dev, reg_addr, data, len);
+}
 
-     bme280_register_read(REGISTER_CTRL_HUM_ADDR,&rx_flag,sizeof(rx_flag));
+void BME280_ctrlmeasInit (void){
 
-     if(rx_flag == 0x8000)
-     {
-          rx_flag = HUM_OVERSAMPLING_NO;
-     }else
-     {
-          rx_flag = humOver;
-     }
-     
-     return rx_flag;
+     bme280Ctx.dirty_u8 |= BMX280_DIRTY_CTRL_MEAS;
+     BMX280_Flush(&bme280Ctx);
 }
 
-static int16_t BME280_FilterInit(BME280_filtermode_e filterStatus){
-     
-     uint8_t flag;
-
-     flag = filterStatus;
-
-     switch (flag)
-     {
-     case BME280_FILTER_OFF:
-          configReg.bit.filter_u3 = 0x00; 
-          break;
-     case BME280_FILTER_X2:
-          configReg.bit.filter_u3 = 0x01;
-          break;
-     case BME280_FILTER_X4:
-          configReg.bit.filter_u3 = 0x02;
-          break;
-     case BME280_FILTER_X8:
-          configReg.bit.filter_u3 = 0x03;
-          break;
-     case BME280_FILTER_X16:
-          configReg.bit.filter_u3 = 0x04;
-          break;
-     }
+void BME280_configRegisterInit(void){
 
-     return flag;
+     bme280Ctx.dirty_u8 |= BMX280_DIRTY_CONFIG;
+     BMX280_Flush(&bme280Ctx);
 }
 
-static int16_t BME280_StandByInit(BME280_standbymode_e standbyStatus){
+void BME280_reset(BME280_resetmode_e resetMode){
      
-     uint8_t flag;
-
-     flag = standbyStatus;
-
-     switch (flag)
-     {
-     case BME280_STANDBY_5: 
-          configReg.bit.t_sb_u3 = 0x00;
-          break;
-     case BME280_STANDBY_625:
-          configReg.bit.t_sb_u3 = 0x01;
-          break;
-     case BME280_STANDBY_1250:
-          configReg.bit.t_sb_u3 = 0x02;
-          break;
-     case BME280_STANDBY_2500:
-          configReg.bit.t_sb_u3 = 0x03;
-          break;
-     case BME280_STANDBY_5000:
-          configReg.bit.t_sb_u3 = 0x04;
-          break;
-     case BME280_STANDBY_10000:
-          configReg.bit.t_sb_u3 = 0x05;
-          break;
-     case BME280_STANDBY_100:
-          configReg.bit.t_sb_u3 = 0x06;
-          break;
-     case BME280_STANDBY_200:
-          configReg.bit.t_sb_u3 = 0x07;
-          break;
+     if(resetMode == BME280_RESET_ENABLE){
+          BMX280_Reset(&bme280Ctx);
      }
-     return flag;
 }
 
-void BME280_ReadTrimmingTemperature(void){
-
-     uint8_t flaglsb_T1;
-     uint8_t flagmsb_T1;
-     uint8_t flaglsb_T2;
-     uint8_t flagmsb_T2;
-     uint8_t flaglsb_T3;
-     uint8_t flagmsb_T3;
-
-     bme280_register_read(REGISTER_CALIBRATION_TEMP1,&flaglsb_T1,sizeof(flaglsb_T1));
-
-     bme280_register_read(REGISTER_CALIBRATION_TEMP2,&flagmsb_T1,sizeof(flagmsb_T1));
+void BME280_Init(I2CBUS_device_t *dev){
 
-     dig_T1 = ((uint16_t)flagmsb_T1 << 8) | flaglsb_T1;
-
-     bme280_register_read(REGISTER_CALIBRATION_TEMP3,&flaglsb_T2,sizeof(flaglsb_T2));
-
-     bme280_register_read(REGISTER_CALIBRATION_TEMP4,&flagmsb_T2,sizeof(flagmsb_T2));
+     BMX280_Init(&bme280Ctx, dev, &bme280Config);    //0xD0, 0x88..0xA1, 0xE1..0xE7, 0xF2, 0xF5, 0xF4
+}
 
-     dig_T2 = ((int16_t)flagmsb_T2 << 8) | flaglsb_T2;
+esp_err_t BME280_ReadTrimming(BME280_calibData_t *calib){
 
-     bme280_register_read(REGISTER_CALIBRATION_TEMP5,&flaglsb_T3,sizeof(flaglsb_T3));
+     esp_err_t status;
 
-     bme280_register_read(REGISTER_CALIBRATION_TEMP6,&flagmsb_T3,sizeof(flagmsb_T3));
+     status = BMX280_ReadTrimming(&bme280Ctx);
+     *calib = bme280Ctx.calib;
 
-     dig_T3 = ((int16_t)flagmsb_T3 << 8) | flaglsb_T3;
+     return status;
 }
 
-int32_t BME280_compensate_T_int32(int32_t adc_T){
+esp_err_t BME280_ReadRawData(BME280_rawData_t *rawData){
 
-     int32_t var1, var2, T;
-     var1 = ((((adc_T>>3) - ((int32_t)dig_T1<<1))) * ((int32_t)dig_T2)) >> 11;
-     var2 = (((((adc_T>>4) - ((int32_t)dig_T1)) * ((adc_T>>4) - ((int32_t)dig_T1)))  >> 12) * ((int32_t)dig_T3)) >> 14;
-     t_fine = var1 + var2;
-     T = (t_fine * 5 + 128) >> 8;
-     return T;
+     return BMX280_ReadRawData(&bme280Ctx, rawData);
 }
 
-static void BME280_ModeInit(BME280_modestatus_e modeStatus){
-
-    uint8_t flag;
+uint32_t BME280_MeasureTimeUs(void){
 
-     flag = modeStatus;
-
-     switch (flag)
-     {
-     case BME280_SLEEP_MODE:
-          ctrl_measConf.bit.mode_u2 = 0x00;
-          break;
-     case BME280_FORCED_MODE:
-          ctrl_measConf.bit.mode_u2 = 0x01;
-          break;
-     case BME280_NORMAL_MODE:
-          ctrl_measConf.bit.mode_u2 = 0x03;
-          break;
-     }
+     return BMX280_MeasureTimeUs(&bme280Ctx);
 }
 
-static int16_t BME280_PressOverSamp(BME280_press_oversampling_e pressOver){
-     uint8_t flag;
-
-     flag = pressOver;
-
-     switch (flag)
-     {
-     case PRESS_OVERSAMPLING_X1:
-          ctrl_measConf.bit.osrs_p_u3 = 0x01;
-          break;
-     case PRESS_OVERSAMPLING_X2:
-          ctrl_measConf.bit.osrs_p_u3 = 0x02;
-          break;
-     case PRESS_OVERSAMPLING_X4:
-          ctrl_measConf.bit.osrs_p_u3 = 0x03;
-          break;
-     case PRESS_OVERSAMPLING_X8:
-          ctrl_measConf.bit.osrs_p_u3 = 0x04;
-          break;
-     case PRESS_OVERSAMPLING_X16:
-          ctrl_measConf.bit.osrs_p_u3 = 0x05;
-          break;
-     }
+esp_err_t BME280_SetMode(BME280_modestatus_e modeStatus){
 
-     return flag;
+     return BMX280_SetMode(&bme280Ctx, modeStatus);
 }
 
-static int16_t BME280_TempOverSamp(BME280_temp_oversampling_e tempOver){
-      
-      uint8_t flag;
-
-      flag = tempOver;
-
-     switch (flag)
-     {
-     case TEMP_OVERSAMPLING_X1:
-          ctrl_measConf.bit.osrs_t_u3 = 0x01;
-          break;
-     case TEMP_OVERSAMPLING_X2:
-          ctrl_measConf.bit.osrs_t_u3 = 0x02;
-          break;
-     case TEMP_OVERSAMPLING_X4:
-          ctrl_measConf.bit.osrs_t_u3 = 0x03;
-          break;
-     case TEMP_OVERSAMPLING_X8:
-          ctrl_measConf.bit.osrs_t_u3 = 0x04;
-          break;
-     case TEMP_OVERSAMPLING_X16:
-          ctrl_measConf.bit.osrs_t_u3 = 0x05;
-          break;
-     }
-
-     return flag;
-}     
-
-/******************************************************************************
- *** GLOBAL FUNCTIONS
- ******************************************************************************/
+esp_err_t BME280_ReadForced(BME280_rawData_t *rawData){
 
-void BME280_ctrlmeasInit (void){
-     
-     BME280_ModeInit(BME280_NORMAL_MODE);
-     BME280_PressOverSamp(PRESS_OVERSAMPLING_X16);
-     BME280_TempOverSamp(TEMP_OVERSAMPLING_X2);
+     return BMX280_ReadForced(&bme280Ctx, rawData);
+}
 
-     bme280_register_write(REGISTER_CTRL_MEAS_ADDR,ctrl_measConf.u8);
+void BME280_DecodeRawData(const uint8_t *burst, BME280_rawData_t *rawData){
 
+     rawData->press_s32 = ((int32_t)burst[0] << 12) | ((int32_t)burst[1] << 4) | (burst[2] >> 4);
+     rawData->temp_s32  = ((int32_t)burst[3] << 12) | ((int32_t)burst[4] << 4) | (burst[5] >> 4);
+     rawData->hum_s32   = ((int32_t)burst[6] << 8) | burst[7];
 }
 
-void BME280_configRegisterInit(void){
+int32_t BME280_compensate_T_int32(int32_t adc_T){
 
-    BME280_FilterInit(BME280_FILTER_X16);
-    BME280_StandByInit(BME280_STANDBY_5);
+     return BMX280_CompensateTemp(&bme280Ctx, adc_T);
+}
 
-    bme280_register_write(REGISTER_CONFIG_ADDR,configReg.u8);
+uint32_t BME280_compensate_P_int64(int32_t adc_P){
 
+     return BMX280_CompensatePress64(&bme280Ctx, adc_P);
 }
 
-void BME280_reset(BME280_resetmode_e resetMode){
-     
-     if(resetMode == BME280_RESET_ENABLE){
-     BME280_registerReset_t resetSelection;
-
-     resetSelection.u8 = 0xB6;
+uint32_t BME280_compensate_P_int32(int32_t adc_P){
 
-     bme280_register_write(REGISTER_RESET_ADDR,resetSelection.u8);
-     }
+     return BMX280_CompensatePress32(&bme280Ctx, adc_P);
 }
 
+uint32_t BME280_compensate_H_int32(int32_t adc_H){
 
-void BME280_Init(void){
-     
-     BME280_ctrlmeasInit();                           // 0xF4                             
-     BME280_HumadityOverSamp(HUM_OVERSAMPLING_X1);    //0xF2
-     BME280_configRegisterInit();                     //0xF5
-                                               
+     return BMX280_CompensateHum(&bme280Ctx, adc_H);
 }
 
-
 int32_t BME280_CalculateTemp(void){
 
-     uint8_t flagxlsb;
-     uint8_t flaglsb;
-     uint8_t flagmsb;
+     BME280_rawData_t rawData;
 
-     bme280_register_read(REGISTER_TEMP_XLSB_ADDR,&flagxlsb,sizeof(flagxlsb));
+     BME280_ReadRawData(&rawData);
 
-     bme280_register_read(REGISTER_TEMP_LSB_ADDR,&flaglsb,sizeof(flaglsb));
+     return BME280_compensate_T_int32(rawData.temp_s32);
+}
 
-     bme280_register_read(REGISTER_TEMP_MSB_ADDR,&flagmsb,sizeof(flagmsb));
+int32_t BME280_CalculateHum(int32_t rawHum){
 
-     rawTemp = (flagmsb << 12) | (flaglsb << 4) | (flagxlsb >> 4);
-     
-     BME280_ReadTrimmingTemperature();
-    
+     return (int32_t)BME280_compensate_H_int32(rawHum);
+}
 
-     return BME280_compensate_T_int32(rawTemp);
+int32_t BME280_CalculatePress(int32_t rawPress){
+
+#if BME280_PRESS_INT64
+     return (int32_t)BME280_compensate_P_int64(rawPress);
+#else
+     return (int32_t)(BME280_compensate_P_int32(rawPress) << 8);
+#endif
 }
 
-uint16_t bme280_median_filter(uint16_t bmeData)
-{
- struct pair
- {
-   struct pair *point;                              /* Pointers forming list linked in sorted order */
-   uint16_t     value;                                   /* Values to sort */
- };
- static struct pair buffer[MEDIAN_FILTER_SIZE] = {0}; /* Buffer of nwidth pairs */
- static struct pair *datpoint = buffer;               /* Pointer into circular buffer of data */
- static struct pair small = {NULL, STOPPER};          /* Chain stopper */
- static struct pair big = {&small, 0};                /* Pointer to head (largest) of linked list.*/
-
- struct pair *successor;                              /* Pointer to successor of replaced data item */
- struct pair *scan;                                   /* Pointer used to scan down the sorted list */
- struct pair *scanold;                                /* Previous value of scan */
- struct pair *median;                                 /* Pointer to median */
- uint16_t i;
-
- if (bmeData == STOPPER)
- {
-   bmeData = STOPPER + 1;                            
- }
- if ( (++datpoint - buffer) >= MEDIAN_FILTER_SIZE)
- {
-   datpoint = buffer;                               
- }
-
- datpoint->value = bmeData;                          
- successor = datpoint->point;                       
- median = &big;                                    
- scanold = NULL;                                    
- scan = &big;                                      
- /* Handle chain-out of first item in chain as special case */
- if (scan->point == datpoint)
- {
-   scan->point = successor;
- }
- scanold = scan;                                     
- scan = scan->point ;                                
-
- /* Loop through the chain, normal loop exit via break. */
- for (i = 0 ; i < MEDIAN_FILTER_SIZE; ++i)
- {
-   /* Handle odd-numbered item in chain  */
-   if (scan->point == datpoint)
-   {
-     scan->point = successor;                      
-   }
-
-   if (scan->value < bmeData)                       
-   {
-     datpoint->point = scanold->point;            
-     scanold->point = datpoint;                    
-     bmeData = STOPPER;
-   };
-
-   /* Step median pointer down chain after doing odd-numbered element */
-   median = median->point;                       
-   if (scan == &small)
-   {
-     break;                                      
-   }
-   scanold = scan;                               
-   scan = scan->point;                          
-
-   /* Handle even-numbered item in chain.  */
-   if (scan->point == datpoint)
-   {
-     scan->point = successor;
-   }
-
-   if (scan->value < bmeData)
-   {
-     datpoint->point = scanold->point;
-     scanold->point = datpoint;
-     bmeData = STOPPER;
-   }
-
-   if (scan == &small)
-   {
-     break;
-   }
-
-   scanold = scan;
-   scan = scan->point;
- }
- return median->value;
+esp_err_t BME280_Compensate(const BME280_rawData_t *rawData, BME280_data_t *data){
+
+     return BMX280_Compensate(&bme280Ctx, rawData, data);
 }
\ No newline at end of file
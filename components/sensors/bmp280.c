@@ -12,407 +12,144 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "bmp280.h"
-
-/******************************************************************************
- *** DEFINES
- ******************************************************************************/
-#define    STOPPER                0                                      
-#define    MEDIAN_FILTER_SIZE     5
+#include "bmx280.h"
 
 /******************************************************************************
  *** VARIABLES
  ******************************************************************************/
-BMP280_registerCtrl_meas_t BMP_ctrl_measConf;
-BMP280_registerConfig_t BMP_configReg;
- uint16_t BMP_dig_T1;
- int16_t BMP_dig_T2;
- int16_t BMP_dig_T3;  
- int32_t BMP_t_fine;
- int32_t BMP_rawTemp;
+/* Single-sensor API on one BMx280 core context, more sensors use bmx280.h */
+static BMX280_t bmp280Ctx;
+static const BMX280_config_t bmp280Config = {
+     .mode      = BME280_NORMAL_MODE,
+     .tempOver  = TEMP_OVERSAMPLING_X2,
+     .pressOver = PRESS_OVERSAMPLING_X16,
+     .humOver   = HUM_OVERSAMPLING_NO,
+     .filter    = BME280_FILTER_X16,
+     .standby   = BME280_STANDBY_5,
+};
 
 
 /******************************************************************************
- *** FUNCTION PROTOTYPES
+ *** GLOBAL FUNCTIONS
  ******************************************************************************/
 
-/** \brief  BMP280 operating mode initialize function
- * \param modeStatus Operating mode selection
- * \return Nothing
- */
-static void BMP280_ModeInit(BMP280_modestatus_e modeStatus);
-
-/** \brief  BMP280 pressure oversampling initialize function
- * \param pressOver Pressure oversampling selection
- * \return Pressure Oversampling status
- */
-static int16_t BMP280_PressOverSamp(BMP280_press_oversampling_e pressOver);
-
-/** \brief  BMP280 temperature oversampling initialize function
- * \param tempOver Temperature oversampling selection
- * \return Temperature Oversampling status
- */
-static int16_t BMP280_TempOverSamp(BMP280_temp_oversampling_e tempOver);
-
-/** \brief  BMP280 internal IIR filter initialize function
- * \param filterStatus Filter mode selection
- * \return 
- */
-static int16_t BMP280_FilterInit(BMP280_filtermode_e filterStatus);
-
-/** \brief  BMP280 controls inactive duration tstandby in normal mode
- * \param standbyStatus StandBy value selection
- * \return 
- */
-static int16_t BMP280_StandByInit(BMP280_standbymode_e standbyStatus);
-
-/** \brief  BMP280 sensor read the trimming parameters
- * \param[] Nothing
- * \return 
- */
-
-void BMP280_ReadTrimmingTemperature(void);
+esp_err_t bmp280_register_write(BMP280_registerAddr_e reg_addr, uint8_t data){
 
-/** \brief  BMP280 sensor read and compensation
- * \param adc_T Raw temperature data
- * \return T Final data
- */
+     return I2CBUS_Write(bmp280Ctx.dev, reg_addr, data);
+}
 
-int32_t BMP280_compensate_T_int32(int32_t adc_T);
+esp_err_t bmp280_register_read(BMP280_registerAddr_e reg_addr, uint8_t *data, size_t len){
 
+     return I2CBUS_BurstRead(bmp280Ctx.dev, reg_addr, data, len);
+}
 
+void BMP280_ctrlmeasInit (void){
 
-/******************************************************************************
- *** LOCAL FUNCTIONS
- ******************************************************************************/
+     bmp280Ctx.dirty_u8 |= BMX280_DIRTY_CTRL_MEAS;
+     BMX280_Flush(&bmp280Ctx);
+}
 
-static int16_t BMP280_FilterInit(BMP280_filtermode_e filterStatus){
-     
-     uint8_t flag;
-
-     flag = filterStatus;
-
-     switch (flag)
-     {
-     case BMP280_FILTER_OFF:
-          BMP_configReg.bit.filter_u3 = 0x00; 
-          break;
-     case BMP280_FILTER_X2:
-          BMP_configReg.bit.filter_u3 = 0x01;
-          break;
-     case BMP280_FILTER_X4:
-          BMP_configReg.bit.filter_u3 = 0x02;
-          break;
-     case BMP280_FILTER_X8:
-          BMP_configReg.bit.filter_u3 = 0x03;
-          break;
-     case BMP280_FILTER_X16:
-          BMP_configReg.bit.filter_u3 = 0x04;
-          break;
-     }
+void BMP280_configRegisterInit(void){
 
-     return flag;
+     bmp280Ctx.dirty_u8 |= BMX280_DIRTY_CONFIG;
+     BMX280_Flush(&bmp280Ctx);
 }
 
-static int16_t BMP280_StandByInit(BMP280_standbymode_e standbyStatus){
+void BMP280_reset(BMP280_resetmode_e resetMode){
      
-     uint8_t flag;
-
-     flag = standbyStatus;
-
-     switch (flag)
-     {
-     case BMP280_STANDBY_5: 
-          BMP_configReg.bit.t_sb_u3 = 0x00;
-          break;
-     case BMP280_STANDBY_625:
-          BMP_configReg.bit.t_sb_u3 = 0x01;
-          break;
-     case BMP280_STANDBY_1250:
-          BMP_configReg.bit.t_sb_u3 = 0x02;
-          break;
-     case BMP280_STANDBY_2500:
-          BMP_configReg.bit.t_sb_u3 = 0x03;
-          break;
-     case BMP280_STANDBY_5000:
-          BMP_configReg.bit.t_sb_u3 = 0x04;
-          break;
-     case BMP280_STANDBY_10000:
-          BMP_configReg.bit.t_sb_u3 = 0x05;
-          break;
-     case BMP280_STANDBY_100:
-          BMP_configReg.bit.t_sb_u3 = 0x06;
-          break;
-     case BMP280_STANDBY_200:
-          BMP_configReg.bit.t_sb_u3 = 0x07;
-          break;
+     if(resetMode == BMP280_RESET_ENABLE){
+          BMX280_Reset(&bmp280Ctx);
      }
-     return flag;
 }
 
-void BMP280_ReadTrimmingTemperature(void){
-
-     uint8_t flaglsb_T1;
-     uint8_t flagmsb_T1;
-     uint8_t flaglsb_T2;
-     uint8_t flagmsb_T2;
-     uint8_t flaglsb_T3;
-     uint8_t flagmsb_T3;
-
-     bmp280_register_read(BMP280_CALIBRATION_TEMP1,&flaglsb_T1,sizeof(flaglsb_T1));
-
-     bmp280_register_read(BMP280_CALIBRATION_TEMP2,&flagmsb_T1,sizeof(flagmsb_T1));
-
-     BMP_dig_T1 = ((uint16_t)flagmsb_T1 << 8) | flaglsb_T1;
+void BMP280_Init(I2CBUS_device_t *dev){
 
-     bmp280_register_read(BMP280_CALIBRATION_TEMP3,&flaglsb_T2,sizeof(flaglsb_T2));
+     BMX280_Init(&bmp280Ctx, dev, &bmp280Config);    //0xD0, 0x88..0x9F, 0xF5, 0xF4
+}
 
-     bmp280_register_read(BMP280_CALIBRATION_TEMP4,&flagmsb_T2,sizeof(flagmsb_T2));
+esp_err_t BMP280_ReadTrimming(BMP280_calibData_t *calib){
 
-     BMP_dig_T2 = ((int16_t)flagmsb_T2 << 8) | flaglsb_T2;
+     esp_err_t status;
 
-     bmp280_register_read(BMP280_CALIBRATION_TEMP5,&flaglsb_T3,sizeof(flaglsb_T3));
+     status = BMX280_ReadTrimming(&bmp280Ctx);
 
-     bmp280_register_read(BMP280_CALIBRATION_TEMP6,&flagmsb_T3,sizeof(flagmsb_T3));
+     calib->dig_T1 = bmp280Ctx.calib.dig_T1;
+     calib->dig_T2 = bmp280Ctx.calib.dig_T2;
+     calib->dig_T3 = bmp280Ctx.calib.dig_T3;
+     calib->dig_P1 = bmp280Ctx.calib.dig_P1;
+     calib->dig_P2 = bmp280Ctx.calib.dig_P2;
+     calib->dig_P3 = bmp280Ctx.calib.dig_P3;
+     calib->dig_P4 = bmp280Ctx.calib.dig_P4;
+     calib->dig_P5 = bmp280Ctx.calib.dig_P5;
+     calib->dig_P6 = bmp280Ctx.calib.dig_P6;
+     calib->dig_P7 = bmp280Ctx.calib.dig_P7;
+     calib->dig_P8 = bmp280Ctx.calib.dig_P8;
+     calib->dig_P9 = bmp280Ctx.calib.dig_P9;
 
-     BMP_dig_T3 = ((int16_t)flagmsb_T3 << 8) | flaglsb_T3;
+     return status;
 }
 
-int32_t BMP280_compensate_T_int32(int32_t adc_T){
-
-     int32_t var1, var2, T;
-     var1 = ((((adc_T>>3) - ((int32_t)BMP_dig_T1<<1))) * ((int32_t)BMP_dig_T2)) >> 11;
-     var2 = (((((adc_T>>4) - ((int32_t)BMP_dig_T1)) * ((adc_T>>4) - ((int32_t)BMP_dig_T1)))  >> 12) * ((int32_t)BMP_dig_T3)) >> 14;
-     BMP_t_fine = var1 + var2;
-     T = (BMP_t_fine * 5 + 128) >> 8;
-     return T;
-}
+esp_err_t BMP280_ReadRawData(BMP280_rawData_t *rawData){
 
-static void BMP280_ModeInit(BMP280_modestatus_e modeStatus){
+     uint8_t burst[BMP280_BURST_READ_SIZE];
+     esp_err_t status;
 
-    uint8_t flag;
+     status = bmp280_register_read(BMP280_PRESS_MSB_ADDR,burst,sizeof(burst));
 
-     flag = modeStatus;
+     BMP280_DecodeRawData(burst, rawData);
 
-     switch (flag)
-     {
-     case BMP280_SLEEP_MODE:
-          BMP_ctrl_measConf.bit.mode_u2 = 0x00;
-          break;
-     case BMP280_FORCED_MODE:
-          BMP_ctrl_measConf.bit.mode_u2 = 0x01;
-          break;
-     case BMP280_NORMAL_MODE:
-          BMP_ctrl_measConf.bit.mode_u2 = 0x03;
-          break;
-     }
+     return status;
 }
 
-static int16_t BMP280_PressOverSamp(BMP280_press_oversampling_e pressOver){
-     uint8_t flag;
-
-     flag = pressOver;
-
-     switch (flag)
-     {
-     case BMP280_PRESS_OVERSAMPLING_X1:
-          BMP_ctrl_measConf.bit.osrs_p_u3 = 0x01;
-          break;
-     case BMP280_PRESS_OVERSAMPLING_X2:
-          BMP_ctrl_measConf.bit.osrs_p_u3 = 0x02;
-          break;
-     case BMP280_PRESS_OVERSAMPLING_X4:
-          BMP_ctrl_measConf.bit.osrs_p_u3 = 0x03;
-          break;
-     case BMP280_PRESS_OVERSAMPLING_X8:
-          BMP_ctrl_measConf.bit.osrs_p_u3 = 0x04;
-          break;
-     case BMP280_PRESS_OVERSAMPLING_X16:
-          BMP_ctrl_measConf.bit.osrs_p_u3 = 0x05;
-          break;
-     }
+uint32_t BMP280_MeasureTimeUs(void){
 
-     return flag;
+     return BMX280_MeasureTimeUs(&bmp280Ctx);
 }
 
-static int16_t BMP280_TempOverSamp(BMP280_temp_oversampling_e tempOver){
-      
-      uint8_t flag;
-
-      flag = tempOver;
-
-     switch (flag)
-     {
-     case BMP280_TEMP_OVERSAMPLING_X1:
-          BMP_ctrl_measConf.bit.osrs_t_u3 = 0x01;
-          break;
-     case BMP280_TEMP_OVERSAMPLING_X2:
-          BMP_ctrl_measConf.bit.osrs_t_u3 = 0x02;
-          break;
-     case BMP280_TEMP_OVERSAMPLING_X4:
-          BMP_ctrl_measConf.bit.osrs_t_u3 = 0x03;
-          break;
-     case BMP280_TEMP_OVERSAMPLING_X8:
-          BMP_ctrl_measConf.bit.osrs_t_u3 = 0x04;
-          break;
-     case BMP280_TEMP_OVERSAMPLING_X16:
-          BMP_ctrl_measConf.bit.osrs_t_u3 = 0x05;
-          break;
-     }
-
-     return flag;
-}     
-
-/******************************************************************************
- *** GLOBAL FUNCTIONS
- ******************************************************************************/
-
-void BMP280_ctrlmeasInit (void){
-     
-     BMP280_ModeInit(BMP280_NORMAL_MODE);
-     BMP280_PressOverSamp(BMP280_PRESS_OVERSAMPLING_X16);
-     BMP280_TempOverSamp(BMP280_TEMP_OVERSAMPLING_X2);
-
-     bmp280_register_write(BMP280_CTRL_MEAS_ADDR,BMP_ctrl_measConf.u8);
+esp_err_t BMP280_SetMode(BMP280_modestatus_e modeStatus){
 
+     /* Same order as BME280_modestatus_e */
+     return BMX280_SetMode(&bmp280Ctx, (BME280_modestatus_e)modeStatus);
 }
 
-void BMP280_configRegisterInit(void){
+esp_err_t BMP280_ReadForced(BMP280_rawData_t *rawData){
 
-    BMP280_FilterInit(BMP280_FILTER_X16);
-    BMP280_StandByInit(BMP280_STANDBY_5);
+     BME280_rawData_t raw;
+     esp_err_t status;
 
-    bmp280_register_write(BMP280_CONFIG_ADDR,BMP_configReg.u8);
+     status = BMX280_ReadForced(&bmp280Ctx, &raw);
 
-}
+     rawData->press_s32 = raw.press_s32;
+     rawData->temp_s32  = raw.temp_s32;
 
-void BMP280_reset(BMP280_resetmode_e resetMode){
-     
-     if(resetMode == BMP280_RESET_ENABLE){
-     BMP280_registerReset_t resetSelection;
+     return status;
+}
 
-     resetSelection.u8 = 0xB6;
+void BMP280_DecodeRawData(const uint8_t *burst, BMP280_rawData_t *rawData){
 
-     bmp280_register_write(BMP280_RESET_ADDR,resetSelection.u8);
-     }
+     rawData->press_s32 = ((int32_t)burst[0] << 12) | ((int32_t)burst[1] << 4) | (burst[2] >> 4);
+     rawData->temp_s32  = ((int32_t)burst[3] << 12) | ((int32_t)burst[4] << 4) | (burst[5] >> 4);
 }
 
+int32_t BMP280_compensate_T_int32(int32_t adc_T){
 
-void BMP280_Init(void){
-     
-     BMP280_ctrlmeasInit();                           // 0xF4                             
-   //  BMP280_HumadityOverSamp(HUM_OVERSAMPLING_X1);    //0xF2
-     BMP280_configRegisterInit();                     //0xF5
-                                               
+     return BMX280_CompensateTemp(&bmp280Ctx, adc_T);
 }
 
-
 int32_t BMP280_CalculateTemp(void){
 
-     uint8_t flagxlsb;
-     uint8_t flaglsb;
-     uint8_t flagmsb;
-
-     bmp280_register_read(BMP280_TEMP_XLSB_ADDR,&flagxlsb,sizeof(flagxlsb));
-
-     bmp280_register_read(BMP280_TEMP_LSB_ADDR,&flaglsb,sizeof(flaglsb));
+     BMP280_rawData_t rawData;
 
-     bmp280_register_read(BMP280_TEMP_MSB_ADDR,&flagmsb,sizeof(flagmsb));
+     BMP280_ReadRawData(&rawData);
 
-     BMP_rawTemp = (flagmsb << 12) | (flaglsb << 4) | (flagxlsb >> 4);
-     
-     BMP280_ReadTrimmingTemperature();
-    
-
-     return BMP280_compensate_T_int32(BMP_rawTemp);
+     return BMP280_compensate_T_int32(rawData.temp_s32);
 }
 
-uint16_t bmp280_median_filter(uint16_t bmpData)
-{
- struct pair
- {
-   struct pair *point;                              /* Pointers forming list linked in sorted order */
-   uint16_t     value;                                   /* Values to sort */
- };
- static struct pair buffer[MEDIAN_FILTER_SIZE] = {0}; /* Buffer of nwidth pairs */
- static struct pair *datpoint = buffer;               /* Pointer into circular buffer of data */
- static struct pair small = {NULL, STOPPER};          /* Chain stopper */
- static struct pair big = {&small, 0};                /* Pointer to head (largest) of linked list.*/
-
- struct pair *successor;                              /* Pointer to successor of replaced data item */
- struct pair *scan;                                   /* Pointer used to scan down the sorted list */
- struct pair *scanold;                                /* Previous value of scan */
- struct pair *median;                                 /* Pointer to median */
- uint16_t i;
-
- if (bmpData == STOPPER)
- {
-   bmpData = STOPPER + 1;                            
- }
-
- if ( (++datpoint - buffer) >= MEDIAN_FILTER_SIZE)
- {
-   datpoint = buffer;                               
- }
-
- datpoint->value = bmpData;                          
- successor = datpoint->point;                      
- median = &big;                                    
- scanold = NULL;                                   
- scan = &big;                                       
-
- /* Handle chain-out of first item in chain as special case */
- if (scan->point == datpoint)
- {
-   scan->point = successor;
- }
- scanold = scan;                                    
- scan = scan->point ;                               
-
- /* Loop through the chain, normal loop exit via break. */
- for (i = 0 ; i < MEDIAN_FILTER_SIZE; ++i)
- {
-   /* Handle odd-numbered item in chain  */
-   if (scan->point == datpoint)
-   {
-     scan->point = successor;                      
-   }
-
-   if (scan->value < bmpData)                        
-   {
-     datpoint->point = scanold->point;            
-     scanold->point = datpoint;                    
-     bmpData = STOPPER;
-   };
-
-   /* Step median pointer down chain after doing odd-numbered element */
-   median = median->point;                       
-   if (scan == &small)
-   {
-     break;                                      
-   }
-   scanold = scan;                               
-   scan = scan->point;                           
-
-   /* Handle even-numbered item in chain.  */
-   if (scan->point == datpoint)
-   {
-     scan->point = successor;
-   }
-
-   if (scan->value < bmpData)
-   {
-     datpoint->point = scanold->point;
-     scanold->point = datpoint;
-     bmpData = STOPPER;
-   }
-
-   if (scan == &small)
-   {
-     break;
-   }
-
-   scanold = scan;
-   scan = scan->point;
- }
- return median->value;
+int32_t BMP280_CalculatePress(int32_t rawPress){
+
+#if BME280_PRESS_INT64
+     return (int32_t)BMX280_CompensatePress64(&bmp280Ctx, rawPress);
+#else
+     return (int32_t)(BMX280_CompensatePress32(&bmp280Ctx, rawPress) << 8);
+#endif
 }
\ No newline at end of file
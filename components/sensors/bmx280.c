@@ -0,0 +1,436 @@
+/**
+ * \file bmx280.c
+ * \author Ugurcan OZTURK
+ * \brief	BME280/BMP280 Shared Driver Core Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "bmx280.h"
+#include "bmx280comp.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    CALIB_READ_SIZE        26    /* 0x88..0xA1, dig_H1 at 0xA1 */
+#define    CALIB_TP_READ_SIZE     24    /* 0x88..0x9F */
+#define    CALIB_HUM_READ_SIZE    7     /* 0xE1..0xE7 */
+#define    CONCAT_BYTES(msb, lsb) (((uint16_t)(msb) << 8) | (uint16_t)(lsb))
+#define    RESET_WORD             0xB6
+#define    MEAS_BASE_US           1250  /* Datasheet maximum measurement time terms */
+#define    MEAS_SAMPLE_US         2300
+#define    MEAS_SETUP_US          575   /* Pressure and humidity channel setup */
+#define    FORCED_POLL_MAX        3     /* Extra ticks to wait for the measuring bit */
+#define    OSRS_MAX               0x05  /* x16 */
+#define    CTRL_READ_SIZE         4     /* 0xF2..0xF5, ctrl_hum, status, ctrl_meas, config */
+#define    FLUSH_PAIRS_MAX        4     /* Sleep, ctrl_hum, config, ctrl_meas */
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  BMx280 register write
+ * \param ctx Context
+ * \param reg_addr Register address
+ * \param data Writing data
+ * \return Bus status
+ */
+static esp_err_t bmx280_register_write(const BMX280_t *ctx, BME280_registerAddr_e reg_addr, uint8_t data);
+
+/** \brief  BMx280 register burst read
+ * \param ctx Context
+ * \param reg_addr First register address
+ * \param data Receive buffer
+ * \param len Data size
+ * \return Bus status
+ */
+static esp_err_t bmx280_register_read(const BMX280_t *ctx, uint8_t reg_addr, uint8_t *data, size_t len);
+
+/** \brief  Oversampling register code to sample count
+ * \param osrs osrs_x field
+ * \return Samples per conversion, 0 when the channel is skipped
+ */
+static uint32_t BMX280_OverSampCount(uint8_t osrs);
+
+/** \brief  Operating mode to the ctrl_meas mode field
+ * \param mode Operating mode selection
+ * \return mode_u2 code
+ */
+static uint8_t BMX280_ModeCode(BME280_modestatus_e mode);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static esp_err_t bmx280_register_write(const BMX280_t *ctx, BME280_registerAddr_e reg_addr, uint8_t data){
+
+     return I2CBUS_Write(ctx->dev, reg_addr, data);
+}
+
+static esp_err_t bmx280_register_read(const BMX280_t *ctx, uint8_t reg_addr, uint8_t *data, size_t len){
+
+     return I2CBUS_BurstRead(ctx->dev, reg_addr, data, len);
+}
+
+static uint32_t BMX280_OverSampCount(uint8_t osrs){
+
+     if(osrs == 0x00){
+          return 0;
+     }
+     if(osrs > OSRS_MAX){
+          osrs = OSRS_MAX;
+     }
+     return 1UL << (osrs - 1);
+}
+
+static uint8_t BMX280_ModeCode(BME280_modestatus_e mode){
+
+     switch (mode)
+     {
+     case BME280_FORCED_MODE:
+          return 0x01;
+     case BME280_NORMAL_MODE:
+          return 0x03;
+     case BME280_SLEEP_MODE:
+     default:
+          return 0x00;
+     }
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+esp_err_t BMX280_Init(BMX280_t *ctx, I2CBUS_device_t *dev, const BMX280_config_t *config){
+
+     uint8_t ctrl[CTRL_READ_SIZE];
+     esp_err_t status;
+
+     ctx->dev = dev;
+     ctx->ctrlHum.u8  = 0;
+     ctx->ctrlMeas.u8 = 0;
+     ctx->config.u8   = 0;
+     ctx->dirty_u8    = 0;
+     ctx->measDev_u8  = 0;
+     ctx->t_fine      = 0;
+
+     status = bmx280_register_read(ctx, REGISTER_ID_ADDR, &ctx->chipId_u8, sizeof(ctx->chipId_u8));
+     if(status != ESP_OK){
+          return status;
+     }
+     if(ctx->chipId_u8 != BMX280_CHIP_ID_BME280 && ctx->chipId_u8 != BMX280_CHIP_ID_BMP280){
+          return ESP_ERR_NOT_FOUND;
+     }
+     ctx->hasHum = (ctx->chipId_u8 == BMX280_CHIP_ID_BME280);
+
+     status = BMX280_ReadTrimming(ctx);
+
+     /* The part keeps its settings over an MCU reset, the shadows start from
+        the registers instead of the power-on values */
+     if(status == ESP_OK){
+          status = bmx280_register_read(ctx, REGISTER_CTRL_HUM_ADDR, ctrl, sizeof(ctrl));
+     }
+     if(status == ESP_OK){
+          ctx->ctrlHum.u8  = ctrl[0];
+          ctx->ctrlMeas.u8 = ctrl[2];
+          ctx->config.u8   = ctrl[3];
+          ctx->measDev_u8  = ctrl[2];
+          status = BMX280_SetConfig(ctx, config);
+     }
+
+     return status;
+}
+
+esp_err_t BMX280_SetConfig(BMX280_t *ctx, const BMX280_config_t *config){
+
+     uint8_t mode = BMX280_ModeCode(config->mode);
+
+     BMX280_SetHumOversampling(ctx, config->humOver);
+     BMX280_SetTempOversampling(ctx, config->tempOver);
+     BMX280_SetPressOversampling(ctx, config->pressOver);
+     BMX280_SetFilter(ctx, config->filter);
+     BMX280_SetStandby(ctx, config->standby);
+
+     if(ctx->ctrlMeas.bit.mode_u2 != mode){
+          ctx->ctrlMeas.bit.mode_u2 = mode;
+          ctx->dirty_u8 |= BMX280_DIRTY_CTRL_MEAS;
+     }
+
+     return BMX280_Flush(ctx);
+}
+
+esp_err_t BMX280_SetMode(BMX280_t *ctx, BME280_modestatus_e mode){
+
+     ctx->ctrlMeas.bit.mode_u2 = BMX280_ModeCode(mode);
+     ctx->dirty_u8 |= BMX280_DIRTY_CTRL_MEAS;
+
+     return BMX280_Flush(ctx);
+}
+
+void BMX280_SetTempOversampling(BMX280_t *ctx, BME280_temp_oversampling_e over){
+
+     /* Enumeration values are the osrs, filter and t_sb register codes */
+     if(ctx->ctrlMeas.bit.osrs_t_u3 != over){
+          ctx->ctrlMeas.bit.osrs_t_u3 = over;
+          ctx->dirty_u8 |= BMX280_DIRTY_CTRL_MEAS;
+     }
+}
+
+void BMX280_SetPressOversampling(BMX280_t *ctx, BME280_press_oversampling_e over){
+
+     if(ctx->ctrlMeas.bit.osrs_p_u3 != over){
+          ctx->ctrlMeas.bit.osrs_p_u3 = over;
+          ctx->dirty_u8 |= BMX280_DIRTY_CTRL_MEAS;
+     }
+}
+
+void BMX280_SetHumOversampling(BMX280_t *ctx, BME280_hum_oversampling_e over){
+
+     if(ctx->hasHum && ctx->ctrlHum.bit.osrs_h_u3 != over){
+          ctx->ctrlHum.bit.osrs_h_u3 = over;
+          ctx->dirty_u8 |= BMX280_DIRTY_CTRL_HUM;
+     }
+}
+
+void BMX280_SetFilter(BMX280_t *ctx, BME280_filtermode_e filter){
+
+     if(ctx->config.bit.filter_u3 != filter){
+          ctx->config.bit.filter_u3 = filter;
+          ctx->dirty_u8 |= BMX280_DIRTY_CONFIG;
+     }
+}
+
+void BMX280_SetStandby(BMX280_t *ctx, BME280_standbymode_e standby){
+
+     if(ctx->config.bit.t_sb_u3 != standby){
+          ctx->config.bit.t_sb_u3 = standby;
+          ctx->dirty_u8 |= BMX280_DIRTY_CONFIG;
+     }
+}
+
+esp_err_t BMX280_Flush(BMX280_t *ctx){
+
+     uint8_t pairs[FLUSH_PAIRS_MAX * 2];
+     BME280_registerCtrl_meas_t meas = { .u8 = ctx->measDev_u8 };
+     size_t len = 0;
+     esp_err_t status;
+
+     if(ctx->dirty_u8 == 0){
+          return ESP_OK;
+     }
+
+     /* config writes are only guaranteed in sleep mode, ctrl_meas restores the mode */
+     if((ctx->dirty_u8 & BMX280_DIRTY_CONFIG) && meas.bit.mode_u2 == BMX280_ModeCode(BME280_NORMAL_MODE)){
+          meas.bit.mode_u2 = BMX280_ModeCode(BME280_SLEEP_MODE);
+          pairs[len++] = REGISTER_CTRL_MEAS_ADDR;
+          pairs[len++] = meas.u8;
+          ctx->dirty_u8 |= BMX280_DIRTY_CTRL_MEAS;
+     }
+
+     /* ctrl_hum takes effect with the next ctrl_meas write */
+     if(ctx->dirty_u8 & BMX280_DIRTY_CTRL_HUM){
+          pairs[len++] = REGISTER_CTRL_HUM_ADDR;
+          pairs[len++] = ctx->ctrlHum.u8;
+          ctx->dirty_u8 |= BMX280_DIRTY_CTRL_MEAS;
+     }
+     if(ctx->dirty_u8 & BMX280_DIRTY_CONFIG){
+          pairs[len++] = REGISTER_CONFIG_ADDR;
+          pairs[len++] = ctx->config.u8;
+     }
+     if(ctx->dirty_u8 & BMX280_DIRTY_CTRL_MEAS){
+          pairs[len++] = REGISTER_CTRL_MEAS_ADDR;
+          pairs[len++] = ctx->ctrlMeas.u8;
+     }
+
+     /* Writes are register/data pairs, the first register goes in the address phase */
+     status = I2CBUS_BurstWrite(ctx->dev, pairs[0], &pairs[1], len - 1);
+
+     /* A forced conversion returns the part to sleep, a later ctrl_meas write
+        must not trigger another one */
+     if(status == ESP_OK){
+          if(ctx->ctrlMeas.bit.mode_u2 == BMX280_ModeCode(BME280_FORCED_MODE)){
+               ctx->ctrlMeas.bit.mode_u2 = BMX280_ModeCode(BME280_SLEEP_MODE);
+          }
+          ctx->dirty_u8   = 0;
+          ctx->measDev_u8 = ctx->ctrlMeas.u8;
+     }
+
+     return status;
+}
+
+esp_err_t BMX280_Reset(BMX280_t *ctx){
+
+     ctx->ctrlHum.u8  = 0;
+     ctx->ctrlMeas.u8 = 0;
+     ctx->config.u8   = 0;
+     ctx->dirty_u8    = 0;
+     ctx->measDev_u8  = 0;
+
+     return bmx280_register_write(ctx, REGISTER_RESET_ADDR, RESET_WORD);
+}
+
+esp_err_t BMX280_ReadTrimming(BMX280_t *ctx){
+
+     uint8_t nvm[CALIB_READ_SIZE];
+     uint8_t nvmHum[CALIB_HUM_READ_SIZE];
+     BME280_calibData_t *calib = &ctx->calib;
+     esp_err_t status;
+
+     /* dig_H1 follows the T/P block after one unused byte */
+     status = bmx280_register_read(ctx, REGISTER_CALIBRATION_TEMP1, nvm,
+                                   ctx->hasHum ? CALIB_READ_SIZE : CALIB_TP_READ_SIZE);
+     if(status != ESP_OK){
+          return status;
+     }
+
+     calib->dig_T1 = CONCAT_BYTES(nvm[1], nvm[0]);
+     calib->dig_T2 = (int16_t)CONCAT_BYTES(nvm[3], nvm[2]);
+     calib->dig_T3 = (int16_t)CONCAT_BYTES(nvm[5], nvm[4]);
+     calib->dig_P1 = CONCAT_BYTES(nvm[7], nvm[6]);
+     calib->dig_P2 = (int16_t)CONCAT_BYTES(nvm[9], nvm[8]);
+     calib->dig_P3 = (int16_t)CONCAT_BYTES(nvm[11], nvm[10]);
+     calib->dig_P4 = (int16_t)CONCAT_BYTES(nvm[13], nvm[12]);
+     calib->dig_P5 = (int16_t)CONCAT_BYTES(nvm[15], nvm[14]);
+     calib->dig_P6 = (int16_t)CONCAT_BYTES(nvm[17], nvm[16]);
+     calib->dig_P7 = (int16_t)CONCAT_BYTES(nvm[19], nvm[18]);
+     calib->dig_P8 = (int16_t)CONCAT_BYTES(nvm[21], nvm[20]);
+     calib->dig_P9 = (int16_t)CONCAT_BYTES(nvm[23], nvm[22]);
+
+     calib->dig_H1 = 0;
+     calib->dig_H2 = 0;
+     calib->dig_H3 = 0;
+     calib->dig_H4 = 0;
+     calib->dig_H5 = 0;
+     calib->dig_H6 = 0;
+
+     if(ctx->hasHum){
+          calib->dig_H1 = nvm[25];
+
+          status = bmx280_register_read(ctx, REGISTER_CALIBRATION_HUM2, nvmHum, sizeof(nvmHum));
+
+          calib->dig_H2 = (int16_t)CONCAT_BYTES(nvmHum[1], nvmHum[0]);
+          calib->dig_H3 = nvmHum[2];
+          calib->dig_H4 = (int16_t)(((int16_t)(int8_t)nvmHum[3] * 16) | (nvmHum[4] & 0x0F));
+          calib->dig_H5 = (int16_t)(((int16_t)(int8_t)nvmHum[5] * 16) | (nvmHum[4] >> 4));
+          calib->dig_H6 = (int8_t)nvmHum[6];
+     }
+
+     return status;
+}
+
+uint32_t BMX280_MeasureTimeUs(const BMX280_t *ctx){
+
+     uint32_t us;
+     uint32_t osrs;
+
+     /* t_measure,max = 1.25 + 2.3 T + (2.3 P + 0.575) + (2.3 H + 0.575) ms */
+     us = MEAS_BASE_US + MEAS_SAMPLE_US * BMX280_OverSampCount(ctx->ctrlMeas.bit.osrs_t_u3);
+     osrs = BMX280_OverSampCount(ctx->ctrlMeas.bit.osrs_p_u3);
+     if(osrs != 0){
+          us += MEAS_SAMPLE_US * osrs + MEAS_SETUP_US;
+     }
+     osrs = ctx->hasHum ? BMX280_OverSampCount(ctx->ctrlHum.bit.osrs_h_u3) : 0;
+     if(osrs != 0){
+          us += MEAS_SAMPLE_US * osrs + MEAS_SETUP_US;
+     }
+
+     return us;
+}
+
+size_t BMX280_BurstSize(const BMX280_t *ctx){
+
+     return ctx->hasHum ? BMX280_BURST_READ_SIZE : BMX280_BURST_NO_HUM_SIZE;
+}
+
+esp_err_t BMX280_ReadRawData(BMX280_t *ctx, BME280_rawData_t *rawData){
+
+     uint8_t burst[BMX280_BURST_READ_SIZE];
+     esp_err_t status;
+
+     status = bmx280_register_read(ctx, REGISTER_PRESS_MSB_ADDR, burst, BMX280_BurstSize(ctx));
+
+     BMX280_DecodeRawData(ctx, burst, rawData);
+
+     return status;
+}
+
+void BMX280_DecodeRawData(const BMX280_t *ctx, const uint8_t *burst, BME280_rawData_t *rawData){
+
+     rawData->press_s32 = ((int32_t)burst[0] << 12) | ((int32_t)burst[1] << 4) | (burst[2] >> 4);
+     rawData->temp_s32  = ((int32_t)burst[3] << 12) | ((int32_t)burst[4] << 4) | (burst[5] >> 4);
+     rawData->hum_s32   = ctx->hasHum ? (((int32_t)burst[6] << 8) | burst[7]) : BME280_HUM_SKIPPED;
+}
+
+esp_err_t BMX280_ReadForced(BMX280_t *ctx, BME280_rawData_t *rawData){
+
+     BME280_registerStatus_t statusReg = { .u8 = 0 };
+     TickType_t ticks;
+     esp_err_t status;
+
+     status = BMX280_SetMode(ctx, BME280_FORCED_MODE);
+     if(status != ESP_OK){
+          return status;
+     }
+
+     /* vTaskDelay may return up to one tick early, round up and add one */
+     ticks = (BMX280_MeasureTimeUs(ctx) + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000) + 1;
+     vTaskDelay(ticks);
+
+     for(uint8_t poll = 0; ; poll++){
+          status = bmx280_register_read(ctx, REGISTER_STATUS_ADDR, &statusReg.u8, sizeof(statusReg.u8));
+          if(status != ESP_OK || !statusReg.bit.measuring_u1){
+               break;
+          }
+          if(poll == FORCED_POLL_MAX){
+               return ESP_ERR_TIMEOUT;
+          }
+          vTaskDelay(1);
+     }
+
+     if(status == ESP_OK){
+          status = BMX280_ReadRawData(ctx, rawData);
+     }
+
+     return status;
+}
+
+int32_t BMX280_CompensateTemp(BMX280_t *ctx, int32_t adc_T){
+
+     ctx->t_fine = BMX280COMP_TFine(&ctx->calib, adc_T);
+     return BMX280COMP_Temp(ctx->t_fine);
+}
+
+uint32_t BMX280_CompensatePress64(const BMX280_t *ctx, int32_t adc_P){
+
+     return BMX280COMP_Press64(&ctx->calib, ctx->t_fine, adc_P);
+}
+
+uint32_t BMX280_CompensatePress32(const BMX280_t *ctx, int32_t adc_P){
+
+     return BMX280COMP_Press32(&ctx->calib, ctx->t_fine, adc_P);
+}
+
+uint32_t BMX280_CompensateHum(const BMX280_t *ctx, int32_t adc_H){
+
+     return BMX280COMP_Hum(&ctx->calib, ctx->t_fine, adc_H);
+}
+
+esp_err_t BMX280_Compensate(const BMX280_t *ctx, const BME280_rawData_t *rawData, BME280_data_t *data){
+
+     /* t_fine stays local, contexts shared between tasks are only read */
+     return BMX280COMP_Compensate(&ctx->calib, ctx->hasHum, rawData, data);
+}
+
+size_t BMX280_CompensateBatch(const BMX280_t *ctx, const BME280_rawData_t *rawData, BME280_data_t *data, size_t count){
+
+     return BMX280COMP_Batch(&ctx->calib, ctx->hasHum, rawData, data, count);
+}
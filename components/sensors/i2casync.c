@@ -0,0 +1,200 @@
+/**
+ * \file i2casync.c
+ * \author Ugurcan OZTURK
+ * \brief	I2C Asynchronous Transaction Engine Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "i2casync.h"
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static portMUX_TYPE engineLock = portMUX_INITIALIZER_UNLOCKED;
+static QueueHandle_t transQueue[I2C_NUM_MAX];
+static TaskHandle_t ownerTask[I2C_NUM_MAX];
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Execute one transaction and signal its completion
+ * \param trans Transaction descriptor
+ * \return Nothing
+ */
+static void I2CASYNC_Execute(I2CASYNC_trans_t *trans);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static void I2CASYNC_Execute(I2CASYNC_trans_t *trans){
+
+     switch (trans->op)
+     {
+     case I2CASYNC_OP_READ:
+          trans->status = I2CBUS_BurstRead(trans->dev, trans->reg, trans->data, trans->len);
+          break;
+     case I2CASYNC_OP_WRITE:
+          trans->status = I2CBUS_BurstWrite(trans->dev, trans->reg, trans->data, trans->len);
+          break;
+     default:
+          trans->status = ESP_ERR_INVALID_ARG;
+          break;
+     }
+
+     if(trans->callback != NULL){
+          trans->callback(trans, trans->arg);
+     }
+
+     if(trans->done != NULL){
+          xSemaphoreGive(trans->done);
+     }
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+esp_err_t I2CASYNC_Init(i2c_port_t port, TaskHandle_t owner){
+
+     QueueHandle_t queue;
+     bool created = false;
+
+     if(port < 0 || port >= I2C_NUM_MAX || owner == NULL){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     queue = xQueueCreate(I2CASYNC_QUEUE_LEN, sizeof(I2CASYNC_trans_t *));
+
+     if(queue == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+
+     /* Submitters on other tasks see the owner together with the queue */
+     portENTER_CRITICAL(&engineLock);
+     if(transQueue[port] == NULL){
+          ownerTask[port] = owner;
+          transQueue[port] = queue;
+          created = true;
+     }
+     portEXIT_CRITICAL(&engineLock);
+
+     if(!created){
+          vQueueDelete(queue);
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     return ESP_OK;
+}
+
+size_t I2CASYNC_Service(i2c_port_t port){
+
+     QueueHandle_t queue;
+     I2CASYNC_trans_t *trans;
+     size_t executed = 0;
+
+     if(port < 0 || port >= I2C_NUM_MAX){
+          return 0;
+     }
+
+     portENTER_CRITICAL(&engineLock);
+     queue = transQueue[port];
+     portEXIT_CRITICAL(&engineLock);
+
+     /* Only what is queued now, a steady submitter cannot starve the owner */
+     for(size_t n = (queue != NULL) ? uxQueueMessagesWaiting(queue) : 0; n != 0; n--){
+          if(xQueueReceive(queue, &trans, 0) != pdTRUE){
+               break;
+          }
+          I2CASYNC_Execute(trans);
+          executed++;
+     }
+
+     return executed;
+}
+
+esp_err_t I2CASYNC_Submit(I2CASYNC_trans_t *trans, TickType_t wait){
+
+     QueueHandle_t queue;
+     TaskHandle_t owner;
+     BaseType_t queued;
+
+     if(trans == NULL || trans->dev == NULL || trans->dev->port < 0 || trans->dev->port >= I2C_NUM_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     portENTER_CRITICAL(&engineLock);
+     queue = transQueue[trans->dev->port];
+     owner = ownerTask[trans->dev->port];
+     portEXIT_CRITICAL(&engineLock);
+
+     if(queue == NULL){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     trans->status = ESP_ERR_TIMEOUT;
+
+     if(trans->urgent){
+          queued = xQueueSendToFront(queue, &trans, wait);
+     }else
+     {
+          queued = xQueueSend(queue, &trans, wait);
+     }
+
+     if(queued != pdTRUE){
+          return ESP_ERR_TIMEOUT;
+     }
+
+     xTaskNotifyGive(owner);
+
+     return ESP_OK;
+}
+
+esp_err_t I2CASYNC_Transfer(I2CASYNC_trans_t *trans){
+
+     StaticSemaphore_t doneBuf;
+     esp_err_t err;
+
+     if(trans == NULL || trans->dev == NULL || trans->dev->port < 0 || trans->dev->port >= I2C_NUM_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     /* The owner would wait for itself */
+     portENTER_CRITICAL(&engineLock);
+     err = (ownerTask[trans->dev->port] == xTaskGetCurrentTaskHandle()) ? ESP_ERR_INVALID_STATE : ESP_OK;
+     portEXIT_CRITICAL(&engineLock);
+
+     if(err != ESP_OK){
+          return err;
+     }
+
+     /* Completion has its own semaphore, the task notification of the caller
+        stays free for interrupts and other users */
+     trans->done = xSemaphoreCreateBinaryStatic(&doneBuf);
+
+     err = I2CASYNC_Submit(trans, portMAX_DELAY);
+
+     if(err == ESP_OK){
+          xSemaphoreTake(trans->done, portMAX_DELAY);
+          err = trans->status;
+     }
+
+     vSemaphoreDelete(trans->done);
+     trans->done = NULL;
+
+     return err;
+}
@@ -0,0 +1,712 @@
+/**
+ * \file i2cbus.c
+ * \author Ugurcan OZTURK
+ * \brief	I2C Bus Device Layer Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "i2cbus.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    I2C_MASTER_TX_BUF_DISABLE     0
+#define    I2C_MASTER_RX_BUF_DISABLE     0
+#define    I2C_CLK_PROBE_FIRST_STEP      1     /* clkSteps index the probe starts at */
+#define    I2C_CLEAR_HALF_PERIOD_US      5     /* 100 kHz bus clear clock */
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+typedef struct{
+
+    i2c_config_t conf;            /* Applied controller configuration */
+    uint32_t     maxErrPermille;  /* Runtime fallback threshold, 0 when disabled */
+    uint32_t     windowTrans;
+    uint32_t     windowErrs;
+}I2CBUS_busState_t;
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static portMUX_TYPE statsLock = portMUX_INITIALIZER_UNLOCKED;
+static I2CBUS_busState_t busState[I2C_NUM_MAX];
+
+/* Selectable SCL frequencies, the runtime fallback steps down this table */
+static const uint32_t clkSteps[] = {100000, 400000, 700000, 1000000};
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Account one transaction in the counters of a device
+ * \param dev Device handle
+ * \param err Transaction status
+ * \param elapsedUs Transaction latency
+ * \param bytesOut Bytes written
+ * \param bytesIn Bytes read
+ * \return err
+ */
+static esp_err_t I2CBUS_Account(I2CBUS_device_t *dev, esp_err_t err, uint32_t elapsedUs, size_t bytesOut, size_t bytesIn);
+
+/** \brief  Count one transaction in the error-rate window of a bus, step the clock down on overflow
+ * \param port I2C controller
+ * \param err Transaction status
+ * \return err
+ */
+static esp_err_t I2CBUS_Adapt(i2c_port_t port, esp_err_t err);
+
+/** \brief  Read the identification register of every probed device, single attempts
+ * \param probes Identification registers
+ * \param count Number of devices
+ * \return  ESP_OK when every read succeeded with the expected value
+ */
+static esp_err_t I2CBUS_ProbeIds(const I2CBUS_probe_t *probes, size_t count);
+
+/** \brief  One accounted transfer, a write when rxLen is 0 else a write then repeated-start read
+ * \param dev Device handle
+ * \param tx Leading transmit bytes
+ * \param txLen Leading transmit size
+ * \param txData Transmit data appended to tx in a write, may be NULL
+ * \param txDataLen Appended transmit size
+ * \param rx Receive buffer
+ * \param rxLen Receive size
+ * \return  Bus status
+ */
+static esp_err_t I2CBUS_Attempt(I2CBUS_device_t *dev, const uint8_t *tx, size_t txLen, const uint8_t *txData, size_t txDataLen, uint8_t *rx, size_t rxLen);
+
+/** \brief  Transfer with quarantine check, bus recovery and retries, arguments as I2CBUS_Attempt
+ * \return  Bus status of the last attempt or ESP_ERR_INVALID_STATE when quarantined
+ */
+static esp_err_t I2CBUS_Execute(I2CBUS_device_t *dev, const uint8_t *tx, size_t txLen, const uint8_t *txData, size_t txDataLen, uint8_t *rx, size_t rxLen);
+
+/** \brief  Batched read of I2CBUS_BatchRead and I2CBUS_ChainRead
+ * \param reads Register block list on one controller
+ * \param count Number of blocks
+ * \param fallback Read every block on its own when the batch fails
+ * \return  ESP_OK when every block status is ESP_OK, else the first failed block status
+ */
+static esp_err_t I2CBUS_Batch(I2CBUS_batchRead_t *reads, size_t count, bool fallback);
+
+/** \brief  Whether a device is in quarantine
+ * \param dev Device handle
+ * \return  true while quarantined
+ */
+static bool I2CBUS_Quarantined(I2CBUS_device_t *dev);
+
+/** \brief  Update the failure streak and quarantine of a device with a call result
+ * \param dev Device handle
+ * \param err Call result
+ * \param firstFailUs esp_timer time of the first failed attempt, 0 when none failed
+ * \return err
+ */
+static esp_err_t I2CBUS_Settle(I2CBUS_device_t *dev, esp_err_t err, int64_t firstFailUs);
+
+/** \brief  Drive a bus clear sequence on the pins of a controller
+ * \param sdaIo SDA pin
+ * \param sclIo SCL pin
+ * \return  Nothing
+ */
+static void I2CBUS_ClearBus(int sdaIo, int sclIo);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static esp_err_t I2CBUS_Account(I2CBUS_device_t *dev, esp_err_t err, uint32_t elapsedUs, size_t bytesOut, size_t bytesIn){
+
+     I2CBUS_stats_t *stats = &dev->stats;
+     uint32_t bucket = 31 - __builtin_clz(elapsedUs | 1);
+
+     if(bucket >= I2CBUS_HIST_BUCKETS){
+          bucket = I2CBUS_HIST_BUCKETS - 1;
+     }
+
+     portENTER_CRITICAL(&statsLock);
+
+     if(stats->transCount == 0 || elapsedUs < stats->minUs){
+          stats->minUs = elapsedUs;
+     }
+     if(elapsedUs > stats->maxUs){
+          stats->maxUs = elapsedUs;
+     }
+     stats->transCount++;
+     stats->totalUs += elapsedUs;
+     stats->hist[bucket]++;
+     stats->bytesOut += bytesOut;
+
+     switch (err)
+     {
+     case ESP_OK:
+          stats->bytesIn += bytesIn;
+          break;
+     case ESP_FAIL:
+          stats->nackCount++;
+          break;
+     case ESP_ERR_TIMEOUT:
+          stats->timeoutCount++;
+          break;
+     default:
+          stats->busErrCount++;
+          break;
+     }
+
+     portEXIT_CRITICAL(&statsLock);
+
+     return err;
+}
+
+static esp_err_t I2CBUS_Adapt(i2c_port_t port, esp_err_t err){
+
+     I2CBUS_busState_t *bus = &busState[port];
+     uint32_t lower = 0;
+
+     portENTER_CRITICAL(&statsLock);
+
+     if(bus->maxErrPermille != 0){
+          bus->windowTrans++;
+          if(err == ESP_FAIL || err == ESP_ERR_TIMEOUT){
+               bus->windowErrs++;
+          }
+
+          /* Trip as soon as the errors alone exceed the rate of a full window */
+          if(bus->windowErrs * 1000 > bus->maxErrPermille * I2CBUS_ADAPT_WINDOW){
+               for(size_t i = 0; i < sizeof(clkSteps) / sizeof(clkSteps[0]); i++){
+                    if(clkSteps[i] < bus->conf.master.clk_speed){
+                         lower = clkSteps[i];
+                    }
+               }
+               bus->windowTrans = I2CBUS_ADAPT_WINDOW;
+          }
+
+          if(bus->windowTrans >= I2CBUS_ADAPT_WINDOW){
+               bus->windowTrans = 0;
+               bus->windowErrs = 0;
+          }
+     }
+
+     portEXIT_CRITICAL(&statsLock);
+
+     if(lower != 0){
+          I2CBUS_SetClock(port, lower);
+     }
+
+     return err;
+}
+
+static esp_err_t I2CBUS_ProbeIds(const I2CBUS_probe_t *probes, size_t count){
+
+     esp_err_t err = ESP_OK;
+     uint8_t id;
+
+     for(size_t i = 0; i < count && err == ESP_OK; i++){
+          for(int r = 0; r < I2CBUS_PROBE_READS && err == ESP_OK; r++){
+               /* One attempt without retries or accounting, a speed that needs a retry fails */
+               err = I2CBUS_ProbeAddr(probes[i].dev->port, probes[i].dev->addr, probes[i].idReg, &id, probes[i].dev->timeoutMs);
+               if(err == ESP_OK && id != probes[i].idValue){
+                    err = ESP_ERR_INVALID_RESPONSE;
+               }
+          }
+     }
+
+     return err;
+}
+
+static esp_err_t I2CBUS_Attempt(I2CBUS_device_t *dev, const uint8_t *tx, size_t txLen, const uint8_t *txData, size_t txDataLen, uint8_t *rx, size_t rxLen){
+
+     esp_err_t err = ESP_ERR_NO_MEM;
+     int64_t startUs = esp_timer_get_time();
+     i2c_cmd_handle_t cmd;
+
+     if(rxLen != 0){
+          err = i2c_master_write_read_device(dev->port, dev->addr, tx, txLen, rx, rxLen, pdMS_TO_TICKS(dev->timeoutMs));
+     }else
+     {
+          cmd = i2c_cmd_link_create();
+
+          if(cmd != NULL){
+               i2c_master_start(cmd);
+               i2c_master_write_byte(cmd, (dev->addr << 1) | I2C_MASTER_WRITE, true);
+               i2c_master_write(cmd, tx, txLen, true);
+               if(txDataLen != 0){
+                    i2c_master_write(cmd, txData, txDataLen, true);
+               }
+               i2c_master_stop(cmd);
+
+               err = i2c_master_cmd_begin(dev->port, cmd, pdMS_TO_TICKS(dev->timeoutMs));
+
+               i2c_cmd_link_delete(cmd);
+          }
+     }
+
+     return I2CBUS_Adapt(dev->port, I2CBUS_Account(dev, err, (uint32_t)(esp_timer_get_time() - startUs), txLen + txDataLen, rxLen));
+}
+
+static esp_err_t I2CBUS_Execute(I2CBUS_device_t *dev, const uint8_t *tx, size_t txLen, const uint8_t *txData, size_t txDataLen, uint8_t *rx, size_t rxLen){
+
+     int64_t firstFailUs = 0;
+     esp_err_t err;
+     uint32_t backoffUs;
+
+     if(I2CBUS_Quarantined(dev)){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     for(uint32_t attempt = 0; ; attempt++){
+          err = I2CBUS_Attempt(dev, tx, txLen, txData, txDataLen, rx, rxLen);
+
+          if(err != ESP_FAIL && err != ESP_ERR_TIMEOUT && err != ESP_ERR_INVALID_STATE){
+               break;
+          }
+          if(firstFailUs == 0){
+               firstFailUs = esp_timer_get_time();
+          }
+          if(attempt >= I2CBUS_RETRY_MAX){
+               break;
+          }
+
+          /* A NACK leaves the bus idle, a timeout may leave a slave holding SDA */
+          if(err != ESP_FAIL && I2CBUS_RecoverBus(dev->port) == ESP_OK){
+               portENTER_CRITICAL(&statsLock);
+               dev->stats.busClearCount++;
+               portEXIT_CRITICAL(&statsLock);
+          }
+
+          portENTER_CRITICAL(&statsLock);
+          dev->stats.retryCount++;
+          portEXIT_CRITICAL(&statsLock);
+
+          /* Backoff shorter than a tick is busy waited, a tick rounding would stretch 1 ms to 10 ms */
+          backoffUs = I2CBUS_BACKOFF_US << attempt;
+          if(backoffUs < portTICK_PERIOD_MS * 1000){
+               esp_rom_delay_us(backoffUs);
+          }else
+          {
+               vTaskDelay((backoffUs + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000));
+          }
+     }
+
+     return I2CBUS_Settle(dev, err, firstFailUs);
+}
+
+static bool I2CBUS_Quarantined(I2CBUS_device_t *dev){
+
+     return dev->quarantineUntilUs != 0 && esp_timer_get_time() < dev->quarantineUntilUs;
+}
+
+static esp_err_t I2CBUS_Settle(I2CBUS_device_t *dev, esp_err_t err, int64_t firstFailUs){
+
+     int64_t nowUs = esp_timer_get_time();
+
+     portENTER_CRITICAL(&statsLock);
+
+     if(firstFailUs != 0 && (uint32_t)(nowUs - firstFailUs) > dev->stats.maxRecoverUs){
+          dev->stats.maxRecoverUs = (uint32_t)(nowUs - firstFailUs);
+     }
+
+     if(err == ESP_OK){
+          dev->failStreak = 0;
+          dev->quarantineUntilUs = 0;
+     }else if(++dev->failStreak >= I2CBUS_QUARANTINE_FAILS){
+          /* Back on probation after the quarantine, one more failure re-arms it */
+          dev->failStreak = I2CBUS_QUARANTINE_FAILS - 1;
+          dev->quarantineUntilUs = nowUs + (int64_t)I2CBUS_QUARANTINE_MS * 1000;
+          dev->stats.quarantineCount++;
+     }
+
+     portEXIT_CRITICAL(&statsLock);
+
+     return err;
+}
+
+static void I2CBUS_ClearBus(int sdaIo, int sclIo){
+
+     gpio_reset_pin(sdaIo);
+     gpio_reset_pin(sclIo);
+     gpio_set_direction(sdaIo, GPIO_MODE_INPUT_OUTPUT_OD);
+     gpio_set_direction(sclIo, GPIO_MODE_INPUT_OUTPUT_OD);
+     gpio_set_pull_mode(sdaIo, GPIO_PULLUP_ONLY);
+     gpio_set_pull_mode(sclIo, GPIO_PULLUP_ONLY);
+     gpio_set_level(sdaIo, 1);
+     gpio_set_level(sclIo, 1);
+     esp_rom_delay_us(I2C_CLEAR_HALF_PERIOD_US);
+
+     /* Clock out the byte a slave may still be sending until it releases SDA */
+     for(int i = 0; i < I2CBUS_CLEAR_CLOCKS && gpio_get_level(sdaIo) == 0; i++){
+          gpio_set_level(sclIo, 0);
+          esp_rom_delay_us(I2C_CLEAR_HALF_PERIOD_US);
+          gpio_set_level(sclIo, 1);
+          esp_rom_delay_us(I2C_CLEAR_HALF_PERIOD_US);
+     }
+
+     /* STOP condition, SDA rising while SCL is high */
+     gpio_set_level(sclIo, 0);
+     esp_rom_delay_us(I2C_CLEAR_HALF_PERIOD_US);
+     gpio_set_level(sdaIo, 0);
+     esp_rom_delay_us(I2C_CLEAR_HALF_PERIOD_US);
+     gpio_set_level(sclIo, 1);
+     esp_rom_delay_us(I2C_CLEAR_HALF_PERIOD_US);
+     gpio_set_level(sdaIo, 1);
+     esp_rom_delay_us(I2C_CLEAR_HALF_PERIOD_US);
+}
+
+static esp_err_t I2CBUS_Batch(I2CBUS_batchRead_t *reads, size_t count, bool fallback){
+
+     esp_err_t err = ESP_OK;
+     i2c_cmd_handle_t cmd;
+     i2c_port_t port;
+     uint32_t timeoutMs = 0;
+     uint32_t elapsedUs;
+     size_t totalBytes = 0;
+     size_t active = 0;
+     int64_t startUs;
+     size_t i, j;
+
+     if(reads == NULL || count == 0){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     port = reads[0].dev->port;
+
+     for(i = 0; i < count; i++){
+          if(reads[i].dev->port != port || reads[i].len == 0){
+               return ESP_ERR_INVALID_ARG;
+          }
+
+          reads[i].status = I2CBUS_Quarantined(reads[i].dev) ? ESP_ERR_INVALID_STATE : ESP_ERR_NOT_FINISHED;
+
+          if(reads[i].status == ESP_ERR_NOT_FINISHED){
+               if(reads[i].dev->timeoutMs > timeoutMs){
+                    timeoutMs = reads[i].dev->timeoutMs;
+               }
+               totalBytes += reads[i].len + 1;
+               active++;
+          }
+     }
+
+     if(active == 0){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     startUs = esp_timer_get_time();
+     cmd = i2c_cmd_link_create();
+
+     if(cmd == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+
+     for(i = 0; i < count && err == ESP_OK; i++){
+          if(reads[i].status != ESP_ERR_NOT_FINISHED){
+               continue;
+          }
+          i2c_master_start(cmd);
+          i2c_master_write_byte(cmd, (reads[i].dev->addr << 1) | I2C_MASTER_WRITE, true);
+          i2c_master_write_byte(cmd, reads[i].reg, true);
+          i2c_master_start(cmd);
+          i2c_master_write_byte(cmd, (reads[i].dev->addr << 1) | I2C_MASTER_READ, true);
+          err = i2c_master_read(cmd, reads[i].data, reads[i].len, I2C_MASTER_LAST_NACK);
+     }
+
+     if(err == ESP_OK){
+          i2c_master_stop(cmd);
+          err = i2c_master_cmd_begin(port, cmd, pdMS_TO_TICKS(timeoutMs));
+     }
+
+     i2c_cmd_link_delete(cmd);
+
+     /* Bus time is shared by bytes, a failed batch counts against every device in it */
+     elapsedUs = (uint32_t)(esp_timer_get_time() - startUs);
+
+     for(i = 0; i < count; i++){
+          if(reads[i].status == ESP_ERR_NOT_FINISHED){
+               I2CBUS_Account(reads[i].dev, err, (uint32_t)(((uint64_t)elapsedUs * (reads[i].len + 1)) / totalBytes), 1, reads[i].len);
+          }
+     }
+
+     I2CBUS_Adapt(port, err);
+
+     if(err != ESP_FAIL && err != ESP_ERR_TIMEOUT && err != ESP_ERR_INVALID_STATE && err != ESP_OK){
+          return err;
+     }
+
+     if(err != ESP_OK && err != ESP_FAIL && I2CBUS_RecoverBus(port) == ESP_OK){
+          portENTER_CRITICAL(&statsLock);
+          for(i = 0; i < count; i++){
+               if(reads[i].status == ESP_ERR_NOT_FINISHED){
+                    reads[i].dev->stats.busClearCount++;
+               }
+          }
+          portEXIT_CRITICAL(&statsLock);
+     }
+
+     /* On failure fall back to one read per block, each with its own retries and
+        quarantine. A chain fails as a whole, its blocks may already have popped
+        FIFO entries and a second read would return the next ones */
+     for(i = 0; i < count; i++){
+          if(reads[i].status != ESP_ERR_NOT_FINISHED){
+               continue;
+          }
+          if(err == ESP_OK){
+               reads[i].status = I2CBUS_Settle(reads[i].dev, ESP_OK, 0);
+          }else if(fallback){
+               reads[i].status = I2CBUS_BurstRead(reads[i].dev, reads[i].reg, reads[i].data, reads[i].len);
+          }else
+          {
+               reads[i].status = err;
+               /* One failed call per device, not one per block */
+               for(j = 0; j < i && reads[j].dev != reads[i].dev; j++);
+               if(j == i){
+                    I2CBUS_Settle(reads[i].dev, err, 0);
+               }
+          }
+     }
+
+     for(i = 0; i < count; i++){
+          if(reads[i].status != ESP_OK){
+               return reads[i].status;
+          }
+     }
+
+     return ESP_OK;
+}
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+esp_err_t I2CBUS_Init(const I2CBUS_busConfig_t *busConf){
+
+     esp_err_t err;
+
+     if(busConf->port < 0 || busConf->port >= I2C_NUM_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     i2c_config_t conf = {
+          .mode = I2C_MODE_MASTER,
+          .sda_io_num = busConf->sdaIo,
+          .scl_io_num = busConf->sclIo,
+          .sda_pullup_en = GPIO_PULLUP_ENABLE,
+          .scl_pullup_en = GPIO_PULLUP_ENABLE,
+          .master.clk_speed = busConf->clkSpeed,
+     };
+
+     err = i2c_param_config(busConf->port, &conf);
+
+     if(err == ESP_OK){
+          err = i2c_driver_install(busConf->port, conf.mode, I2C_MASTER_RX_BUF_DISABLE, I2C_MASTER_TX_BUF_DISABLE, 0);
+     }
+
+     if(err == ESP_OK){
+          memset(&busState[busConf->port], 0, sizeof(busState[busConf->port]));
+          busState[busConf->port].conf = conf;
+     }
+
+     return err;
+}
+
+esp_err_t I2CBUS_Read(I2CBUS_device_t *dev, uint8_t reg, uint8_t *data){
+
+     return I2CBUS_WriteRead(dev, &reg, 1, data, 1);
+}
+
+esp_err_t I2CBUS_Write(I2CBUS_device_t *dev, uint8_t reg, uint8_t data){
+
+     return I2CBUS_Execute(dev, &reg, 1, &data, 1, NULL, 0);
+}
+
+esp_err_t I2CBUS_BurstRead(I2CBUS_device_t *dev, uint8_t reg, uint8_t *data, size_t len){
+
+     return I2CBUS_WriteRead(dev, &reg, 1, data, len);
+}
+
+esp_err_t I2CBUS_BurstWrite(I2CBUS_device_t *dev, uint8_t reg, const uint8_t *data, size_t len){
+
+     return I2CBUS_Execute(dev, &reg, 1, data, len, NULL, 0);
+}
+
+esp_err_t I2CBUS_WriteRead(I2CBUS_device_t *dev, const uint8_t *txData, size_t txLen, uint8_t *rxData, size_t rxLen){
+
+     return I2CBUS_Execute(dev, txData, txLen, NULL, 0, rxData, rxLen);
+}
+
+esp_err_t I2CBUS_BatchRead(I2CBUS_batchRead_t *reads, size_t count){
+
+     return I2CBUS_Batch(reads, count, true);
+}
+
+esp_err_t I2CBUS_ChainRead(I2CBUS_batchRead_t *reads, size_t count){
+
+     return I2CBUS_Batch(reads, count, false);
+}
+
+esp_err_t I2CBUS_RecoverBus(i2c_port_t port){
+
+     i2c_config_t conf;
+     esp_err_t err;
+
+     if(port < 0 || port >= I2C_NUM_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     conf = busState[port].conf;
+
+     i2c_driver_delete(port);
+     I2CBUS_ClearBus(conf.sda_io_num, conf.scl_io_num);
+
+     err = i2c_param_config(port, &conf);
+
+     if(err == ESP_OK){
+          err = i2c_driver_install(port, conf.mode, I2C_MASTER_RX_BUF_DISABLE, I2C_MASTER_TX_BUF_DISABLE, 0);
+     }
+
+     return err;
+}
+
+void I2CBUS_GetStats(I2CBUS_device_t *dev, I2CBUS_stats_t *snapshot){
+
+     portENTER_CRITICAL(&statsLock);
+     *snapshot = dev->stats;
+     portEXIT_CRITICAL(&statsLock);
+}
+
+void I2CBUS_ResetStats(I2CBUS_device_t *dev){
+
+     portENTER_CRITICAL(&statsLock);
+     memset(&dev->stats, 0, sizeof(dev->stats));
+     portEXIT_CRITICAL(&statsLock);
+}
+
+uint32_t I2CBUS_AvgLatencyUs(const I2CBUS_stats_t *snapshot){
+
+     return (snapshot->transCount != 0) ? (uint32_t)(snapshot->totalUs / snapshot->transCount) : 0;
+}
+
+esp_err_t I2CBUS_ProbeClock(i2c_port_t port, const I2CBUS_probe_t *probes, size_t count){
+
+     I2CBUS_busState_t *bus;
+     uint32_t maxErrPermille;
+     uint32_t limit = UINT32_MAX;
+     uint32_t best = 0;
+     esp_err_t err = ESP_OK;
+
+     if(port < 0 || port >= I2C_NUM_MAX || probes == NULL || count == 0){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     bus = &busState[port];
+
+     for(size_t i = 0; i < count; i++){
+          if(probes[i].dev->port != port){
+               return ESP_ERR_INVALID_ARG;
+          }
+          if(probes[i].dev->clkSpeed < limit){
+               limit = probes[i].dev->clkSpeed;
+          }
+     }
+
+     /* Probe errors are expected, keep them out of the runtime fallback */
+     portENTER_CRITICAL(&statsLock);
+     maxErrPermille = bus->maxErrPermille;
+     bus->maxErrPermille = 0;
+     portEXIT_CRITICAL(&statsLock);
+
+     for(size_t s = I2C_CLK_PROBE_FIRST_STEP; s < sizeof(clkSteps) / sizeof(clkSteps[0]) && err == ESP_OK; s++){
+          if(clkSteps[s] > limit){
+               break;
+          }
+
+          err = I2CBUS_SetClock(port, clkSteps[s]);
+
+          if(err == ESP_OK){
+               err = I2CBUS_ProbeIds(probes, count);
+          }
+          if(err == ESP_OK){
+               best = clkSteps[s];
+          }else if(err != ESP_FAIL && err != ESP_ERR_INVALID_RESPONSE){
+               /* Probe reads do not recover the bus, a failed speed may leave a slave holding SDA */
+               I2CBUS_RecoverBus(port);
+          }
+     }
+
+     err = I2CBUS_SetClock(port, (best != 0) ? best : clkSteps[0]);
+
+     portENTER_CRITICAL(&statsLock);
+     bus->maxErrPermille = maxErrPermille;
+     bus->windowTrans = 0;
+     bus->windowErrs = 0;
+     portEXIT_CRITICAL(&statsLock);
+
+     if(err == ESP_OK && best == 0){
+          err = ESP_ERR_NOT_FOUND;
+     }
+
+     return err;
+}
+
+esp_err_t I2CBUS_ProbeAddr(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t *data, uint32_t timeoutMs){
+
+     if(port < 0 || port >= I2C_NUM_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     return i2c_master_write_read_device(port, addr, &reg, 1, data, 1, pdMS_TO_TICKS(timeoutMs));
+}
+
+esp_err_t I2CBUS_SetClock(i2c_port_t port, uint32_t clkSpeed){
+
+     i2c_config_t conf;
+     esp_err_t err;
+
+     if(port < 0 || port >= I2C_NUM_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     conf = busState[port].conf;
+     conf.master.clk_speed = clkSpeed;
+
+     /* The legacy driver accepts new timing once installed, callers on other
+        tasks must not have a transaction in flight on this controller */
+     err = i2c_param_config(port, &conf);
+
+     if(err == ESP_OK){
+          portENTER_CRITICAL(&statsLock);
+          busState[port].conf.master.clk_speed = clkSpeed;
+          portEXIT_CRITICAL(&statsLock);
+     }
+
+     return err;
+}
+
+uint32_t I2CBUS_GetClock(i2c_port_t port){
+
+     return (port >= 0 && port < I2C_NUM_MAX) ? busState[port].conf.master.clk_speed : 0;
+}
+
+void I2CBUS_SetAdaptive(i2c_port_t port, uint32_t maxErrPermille){
+
+     if(port < 0 || port >= I2C_NUM_MAX){
+          return;
+     }
+
+     portENTER_CRITICAL(&statsLock);
+     busState[port].maxErrPermille = maxErrPermille;
+     busState[port].windowTrans = 0;
+     busState[port].windowErrs = 0;
+     portEXIT_CRITICAL(&statsLock);
+}
@@ -10,7 +10,29 @@
  *** INCLUDES
  ******************************************************************************/
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
 #include "adxl345Config.h"
+#include "i2cbus.h"
+
+/******************************************************************************
+*** DEFINES
+******************************************************************************/
+#define    ADXL345_AXIS_READ_SIZE    2     /* DATAx0, DATAx1 */
+#define    ADXL345_DEVID             0xE5  /* REGISTER_DEVID_ADDR content */
+#define    ADXL345_FRAME_SIZE        6     /* DATAX0..DATAZ1, one FIFO entry */
+#define    ADXL345_FIFO_ENTRIES_MAX  33    /* 32 FIFO levels and the data registers */
+#define    ADXL345_SCALE_UG_LSB      3900  /* Full resolution and +-2g, micro g per LSB */
+#define    ADXL345_THRESH_MG_LSB     62.5f /* THRESH_TAP, THRESH_ACT, THRESH_INACT, THRESH_FF scale */
+#define    ADXL345_SPI_CLK_MAX       5000000
+#define    ADXL345_SPI_MODE          3     /* CPOL = 1, CPHA = 1 */
+#define    ADXL345_SPI_READ          0x80  /* Header byte R/W bit */
+#define    ADXL345_SPI_MB            0x40  /* Header byte multi-byte bit, address increments */
+#define    ADXL345_SPI_BURST_MAX     8     /* Longest single register burst over SPI */
+#define    ADXL345_SPI_TIMEOUT_MS    20
+
 
 /******************************************************************************
 *** VARIABLES
@@ -384,50 +406,150 @@ typedef union {
 	uint8_t u8;
 }ADXL_fifoctl_t;
 
-/** @union ADXL_fifoctl_t
+/** @union ADXL_fifostatus_t
 *   @brief ADXL345 FIFO_STATUS register bit field
 */
 typedef union {
 
 	struct 
 	{
-		uint8_t entries_u5  : 5;
+		uint8_t entries_u6  : 6;
 		uint8_t reserved_u1 : 1;
 		uint8_t fifoTrig_u1 : 1;
 	}bit;
+	uint8_t u8;
 }ADXL_fifostatus_t;
 
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct ADXL_sample_t
+*   @brief ADXL345 one x, y, z output frame, non calibration
+*/
+typedef struct {
+
+	int16_t x_s16;
+	int16_t y_s16;
+	int16_t z_s16;
+}ADXL_sample_t;
+
+/** @struct ADXL_accel_t
+*   @brief ADXL345 one x, y, z output frame scaled to mg
+*/
+typedef struct {
+
+	int16_t x_mg_s16;
+	int16_t y_mg_s16;
+	int16_t z_mg_s16;
+}ADXL_accel_t;
+
+/** @struct ADXL_spiConfig_t
+*   @brief ADXL345 4-wire SPI pins and clock
+*/
+typedef struct {
+
+	spi_host_device_t host;
+	int               mosiIo;
+	int               misoIo;
+	int               sclkIo;
+	int               csIo;
+	uint32_t          clkSpeed;     /* SCLK (Hz), capped at ADXL345_SPI_CLK_MAX */
+}ADXL_spiConfig_t;
+
+/** @struct ADXL_motionConfig_t
+*   @brief ADXL345 activity and inactivity detection, linked auto sleep
+*/
+typedef struct {
+
+	uint8_t             actThresh_u8;     /* 62.5 mg/LSB */
+	uint8_t             inactThresh_u8;   /* 62.5 mg/LSB */
+	uint8_t             inactTime_u8;     /* 1 s/LSB below inactThresh before inactivity */
+	ADXL_actinact_ctl_t ctl;              /* Participating axes and AC/DC coupling */
+	uint8_t             autoSleep_u1;     /* Link activity/inactivity and sleep on inactivity */
+	uint8_t             wakeup_u2;        /* Sleep rate 8, 4, 2, 1 Hz */
+}ADXL_motionConfig_t;
+
+/** @struct ADXL_tapConfig_t
+*   @brief ADXL345 single and double tap detection
+*/
+typedef struct {
+
+	uint8_t        thresh_u8;             /* 62.5 mg/LSB */
+	uint8_t        dur_u8;                /* 625 us/LSB, max time above thresh */
+	uint8_t        latent_u8;             /* 1.25 ms/LSB, 0 disables double tap */
+	uint8_t        window_u8;             /* 1.25 ms/LSB, second tap window */
+	ADXL_tapaxes_t axes;
+}ADXL_tapConfig_t;
+
+/** @struct ADXL_freefallConfig_t
+*   @brief ADXL345 free-fall detection
+*/
+typedef struct {
+
+	uint8_t thresh_u8;                    /* 62.5 mg/LSB, all axes below */
+	uint8_t time_u8;                      /* 5 ms/LSB, min time below thresh */
+}ADXL_freefallConfig_t;
+
 /******************************************************************************
  *** FUNCTION PROTOTYPES
  ******************************************************************************/
 
 
  /** \brief  ADXL345 general initialize function
-  * \param[]
+  * \param dev I2C device handle of the sensor
   * \return Nothing
   */
-void ADXL345_Init(void);
+void ADXL345_Init(I2CBUS_device_t *dev);
+
+/** \brief  ADXL345 initialize over 4-wire SPI instead of I2C, the bus is set up
+ *          with DMA and the FIFO is drained with queued transactions
+ * \param config SPI host, pins and clock
+ * \return SPI driver status, ESP_ERR_NOT_FOUND when DEVID does not answer
+ */
+esp_err_t ADXL345_InitSpi(const ADXL_spiConfig_t *config);
+
+/** \brief  ADXL345 output data rate, low power bit kept
+ * \param rate Data rate and bandwidth
+ * \return Bus status
+ */
+esp_err_t ADXL345_SetDataRate(ADXL_powerdataratebw_e rate);
+
+/** \brief  ADXL345 write the shadow registers changed since the last flush,
+ *          contiguous ones in one burst
+ * \param[] Nothing
+ * \return Bus status, failed registers stay dirty
+ */
+esp_err_t ADXL345_Flush(void);
 
-/** \brief  ADXL345 calculate x,y,z axis data
- * \param[]
+/** \brief  ADXL345 calculate x,y,z axis data, one 6 byte burst from DATAX0 so
+ *          the three axes belong to the same output sample
+ * \param accel Axis data in mg, scaled from the configured range and resolution
+ * \return Bus status
+ */
+esp_err_t ADXL345_CalculateData(ADXL_accel_t *accel);
+
+/** \brief  ADXL345 scale one raw frame to mg with the configured DATA_FORMAT
+ * \param sample Raw frame, e.g. from ADXL345_ReadFifo
+ * \param accel Axis data in mg
  * \return Nothing
  */
-void ADXL345_CalculateData(void);
+void ADXL345_ScaleFrame(const ADXL_sample_t *sample, ADXL_accel_t *accel);
 
 /** \brief  ADXL345 read register function
  * \param reg_addr Register address
  * \param data Reading data buffer
  * \param len Reading data size
- * \return 0
+ * \return Bus status
  */
-int16_t adxl_register_read(ADXL_registeraddr_e reg_addr, uint8_t *data, size_t len);
+esp_err_t adxl_register_read(ADXL_registeraddr_e reg_addr, uint8_t *data, size_t len);
 
 /** \brief  ADXL345 write register function
  * \param reg_addr Register address
- * \param data Reading data buffer
- * \return 0
+ * \param data Writing data
+ * \return Bus status
  */
-int16_t adxl_register_write(ADXL_registeraddr_e reg_addr, uint8_t data);
+esp_err_t adxl_register_write(ADXL_registeraddr_e reg_addr, uint8_t data);
 
 /** \brief  ADXL345 X axis non calibration data calculating
  * \param[] Nothing
@@ -447,8 +569,82 @@ int16_t ADXL345_YaxisCalculate(void);
  */
 int16_t ADXL345_ZaxisCalculate(void);
 
-/** \brief  ADXL345 sensor data filtering
- * \param adxlData Raw temperature data
- * \return Filtering data 
+/** \brief  ADXL345 decode one axis from its two data registers
+ * \param raw ADXL345_AXIS_READ_SIZE bytes read from DATAx0
+ * \return Non calibration axis data
+ */
+int16_t ADXL345_DecodeAxis(const uint8_t *raw);
+
+/** \brief  ADXL345 FIFO watermark, INT_SOURCE watermark is set at this many entries
+ * \param samples FIFO_CTL samples field, 0..31
+ * \return Bus status
+ */
+esp_err_t ADXL345_SetWatermark(uint8_t samples);
+
+/** \brief  ADXL345 drain queued FIFO entries with one 6 byte burst per entry,
+ *          all bursts chained in one I2C transaction. A failed drain returns no
+ *          samples, the caller drops the stream up to it
+ * \param block Caller sample buffer
+ * \param maxSamples Buffer size in samples, entries beyond it stay queued
+ * \param count Number of samples written to block, 0 on failure
+ * \return Bus status
+ */
+esp_err_t ADXL345_ReadFifo(ADXL_sample_t *block, size_t maxSamples, size_t *count);
+
+/** \brief  ADXL345 decode one x, y, z frame
+ * \param raw ADXL345_FRAME_SIZE bytes read from DATAX0
+ * \param sample Decoded frame
+ * \return Nothing
+ */
+void ADXL345_DecodeFrame(const uint8_t *raw, ADXL_sample_t *sample);
+
+/** \brief  ADXL345 interrupt sources and their output pin, INT_MAP is written
+ *          before INT_ENABLE so no source fires on the wrong pin
+ * \param enable Sources to enable
+ * \param map Sources routed to INT2, the others go to INT1
+ * \return Bus status
+ */
+esp_err_t ADXL345_ConfigInterrupts(ADXL_intenable_t enable, ADXL_intmap_t map);
+
+/** \brief  ADXL345 attach a rising edge GPIO ISR to an interrupt output, the
+ *          ISR sends a direct-to-task notification to the acquisition task
+ * \param gpio Pin wired to INT1 or INT2
+ * \param task Task notified with vTaskNotifyGiveFromISR
+ * \return GPIO driver status
+ */
+esp_err_t ADXL345_AttachInterrupt(gpio_num_t gpio, TaskHandle_t task);
+
+/** \brief  ADXL345 interrupt service, reads INT_SOURCE then drains the FIFO on
+ *          watermark or overrun, or reads the single frame on data ready
+ * \param block Caller sample buffer
+ * \param maxSamples Buffer size in samples
+ * \param count Number of samples written to block
+ * \param source INT_SOURCE content, other event bits clear on this read
+ * \return Bus status
+ */
+esp_err_t ADXL345_Service(ADXL_sample_t *block, size_t maxSamples, size_t *count, ADXL_intsource_t *source);
+
+/** \brief  ADXL345 activity and inactivity detection, with autoSleep_u1 the
+ *          part links both functions and drops to the wakeup rate on inactivity
+ * \param config Thresholds, inactivity time, coupling and sleep settings
+ * \return Bus status
+ */
+esp_err_t ADXL345_ConfigMotion(const ADXL_motionConfig_t *config);
+
+/** \brief  ADXL345 single and double tap detection
+ * \param config Tap thresholds, timing and axes
+ * \return Bus status
+ */
+esp_err_t ADXL345_ConfigTap(const ADXL_tapConfig_t *config);
+
+/** \brief  ADXL345 free-fall detection
+ * \param config Free-fall threshold and time
+ * \return Bus status
+ */
+esp_err_t ADXL345_ConfigFreeFall(const ADXL_freefallConfig_t *config);
+
+/** \brief  ADXL345 first axis and sleep state of the last activity and tap events
+ * \param status ACT_TAP_STATUS content
+ * \return Bus status
  */
-uint16_t adxl_median_filter(uint16_t adxlData);
\ No newline at end of file
+esp_err_t ADXL345_ReadActTapStatus(ADXL_acttap_status_t *status);
@@ -5,10 +5,26 @@
  * \date 26.03.2024
  */
 
+#ifndef BME280_H_
+#define BME280_H_
+
  /******************************************************************************
  *** INCLUDES
  ******************************************************************************/
 #include "bme280Config.h"
+#include "i2cbus.h"
+
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    BME280_BURST_READ_SIZE    8     /* 0xF7..0xFE */
+#define    BME280_CHIP_ID            0x60  /* REGISTER_ID_ADDR content */
+#define    BME280_PRESS_SKIPPED      0x80000 /* Raw pressure of a skipped conversion */
+#define    BME280_HUM_SKIPPED        0x8000  /* Raw humidity of a skipped conversion */
+#define    BME280_PRESS_INT64        1     /* 0 selects the 32 bit pressure compensation, 1 Pa resolution */
+#define    BME280_PRESS_Q8_ONE       256   /* Pressure unit is 1/256 Pa */
+#define    BME280_HUM_Q10_ONE        1024  /* Humidity unit is 1/1024 %RH */
 
 
 /******************************************************************************
@@ -42,13 +58,19 @@ typedef enum{
     REGISTER_HUM_LSB_ADDR    = 0xFE
 }BME280_registerAddr_e;
 
+/** @enum BME280_calibrationaddr_e
+*   @brief BME280 trimming parameter addresses
+*/
 typedef enum{
     REGISTER_CALIBRATION_TEMP1 = 0x88,
     REGISTER_CALIBRATION_TEMP2,
     REGISTER_CALIBRATION_TEMP3,
     REGISTER_CALIBRATION_TEMP4,
     REGISTER_CALIBRATION_TEMP5,
-    REGISTER_CALIBRATION_TEMP6
+    REGISTER_CALIBRATION_TEMP6,
+    REGISTER_CALIBRATION_PRESS1,
+    REGISTER_CALIBRATION_HUM1  = 0xA1,
+    REGISTER_CALIBRATION_HUM2  = 0xE1
 
 }BME280_calibrationaddr_e;
 
@@ -138,6 +160,7 @@ typedef union{
     struct 
     {
         uint8_t spi3w_en_u1: 1;
+        uint8_t reserved_u1: 1;
         uint8_t filter_u3  : 3;
         uint8_t t_sb_u3    : 3;
     }bit;
@@ -251,16 +274,65 @@ typedef union{
     uint8_t u8;
 }BME280_registerhum_lsb_t;
 
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct BME280_rawData_t
+*   @brief BME280 uncompensated measurement snapshot (0xF7..0xFE)
+*/
+typedef struct{
+
+    int32_t press_s32;   /* 20 bit pressure    */
+    int32_t temp_s32;    /* 20 bit temperature */
+    int32_t hum_s32;     /* 16 bit humidity    */
+}BME280_rawData_t;
+
+/** @struct BME280_data_t
+*   @brief BME280 compensated measurement of one snapshot
+*/
+typedef struct{
+
+    int32_t  temp_s32;   /* 0.01 DegC          */
+    uint32_t press_u32;  /* Pa, Q24.8          */
+    uint32_t hum_u32;    /* %RH, Q22.10        */
+}BME280_data_t;
+
+/** @struct BME280_calibData_t
+*   @brief BME280 trimming parameters, read once from NVM at initialize
+*/
+typedef struct{
+
+    uint16_t dig_T1;
+    int16_t  dig_T2;
+    int16_t  dig_T3;
+    uint16_t dig_P1;
+    int16_t  dig_P2;
+    int16_t  dig_P3;
+    int16_t  dig_P4;
+    int16_t  dig_P5;
+    int16_t  dig_P6;
+    int16_t  dig_P7;
+    int16_t  dig_P8;
+    int16_t  dig_P9;
+    uint8_t  dig_H1;
+    int16_t  dig_H2;
+    uint8_t  dig_H3;
+    int16_t  dig_H4;
+    int16_t  dig_H5;
+    int8_t   dig_H6;
+}BME280_calibData_t;
+
 
 /******************************************************************************
  *** FUNCTION PROTOTYPES
  ******************************************************************************/
 
 /** \brief  BME280 sensor initialize function
- * \param[] Nothing
+ * \param dev I2C device handle of the sensor
  * \return  Nothing
  */
-void BME280_Init(void);
+void BME280_Init(I2CBUS_device_t *dev);
 
 /** \brief  BME280 sensor reset disable or enable function
  * \param resetMode Enable or Disable
@@ -289,16 +361,16 @@ void BME280_reset(BME280_resetmode_e resetMode);
  * \param reg_addr register address
  * \param data receive data buffer
  * \param len data size
- * \return  
+ * \return  Bus status
  */
-int16_t bme280_register_read(BME280_registerAddr_e reg_addr, uint8_t *data, size_t len);
+esp_err_t bme280_register_read(BME280_registerAddr_e reg_addr, uint8_t *data, size_t len);
 
 /** \brief  BME280 sensor write to register function
  * \param reg_addr register address
  * \param data transmit data buffer
- * \return  
+ * \return  Bus status
  */
-int16_t bme280_register_write(BME280_registerAddr_e reg_addr, uint8_t data);
+esp_err_t bme280_register_write(BME280_registerAddr_e reg_addr, uint8_t data);
 
 /** \brief  BME280 sensor calculate temperature data
  * \param[]
@@ -306,20 +378,85 @@ int16_t bme280_register_write(BME280_registerAddr_e reg_addr, uint8_t data);
  */
 int32_t BME280_CalculateTemp(void);
 
+/** \brief  BME280 sensor read all data registers in one burst transaction
+ * \param rawData Uncompensated measurement snapshot
+ * \return  Bus status
+ */
+esp_err_t BME280_ReadRawData(BME280_rawData_t *rawData);
+
+/** \brief  BME280 sensor datasheet maximum measurement time of the selected oversampling
+ * \param[] Nothing
+ * \return  Conversion time in us
+ */
+uint32_t BME280_MeasureTimeUs(void);
+
+/** \brief  BME280 sensor write the operating mode, normal mode converts continuously
+ * \param modeStatus Operating mode selection
+ * \return  Bus status
+ */
+esp_err_t BME280_SetMode(BME280_modestatus_e modeStatus);
+
+/** \brief  BME280 sensor one-shot forced mode measurement: trigger, wait the maximum
+ *          measurement time, confirm the measuring bit is clear, then burst read
+ * \param rawData Uncompensated measurement snapshot
+ * \return  Bus status, ESP_ERR_TIMEOUT when the conversion does not finish
+ */
+esp_err_t BME280_ReadForced(BME280_rawData_t *rawData);
+
+/** \brief  BME280 sensor decode a burst of the data registers
+ * \param burst BME280_BURST_READ_SIZE bytes read from 0xF7..0xFE
+ * \param rawData Uncompensated measurement snapshot
+ * \return  Nothing
+ */
+void BME280_DecodeRawData(const uint8_t *burst, BME280_rawData_t *rawData);
+
+/** \brief  BME280 sensor temperature compensation
+ * \param adc_T Raw temperature data
+ * \return  Temperature in 0.01 DegC
+ */
+int32_t BME280_compensate_T_int32(int32_t adc_T);
+
+/** \brief  BME280 sensor pressure compensation, 64 bit integer
+ * \param adc_P Raw pressure data
+ * \return  Pressure in Pa, Q24.8, needs t_fine of the same snapshot
+ */
+uint32_t BME280_compensate_P_int64(int32_t adc_P);
+
+/** \brief  BME280 sensor pressure compensation, 32 bit integer
+ * \param adc_P Raw pressure data
+ * \return  Pressure in Pa, needs t_fine of the same snapshot
+ */
+uint32_t BME280_compensate_P_int32(int32_t adc_P);
+
+/** \brief  BME280 sensor humidity compensation, 32 bit integer
+ * \param adc_H Raw humidity data
+ * \return  Humidity in %RH, Q22.10, needs t_fine of the same snapshot
+ */
+uint32_t BME280_compensate_H_int32(int32_t adc_H);
+
+/** \brief  BME280 sensor compensate every channel of one snapshot
+ * \param rawData Uncompensated measurement snapshot
+ * \param data Compensated measurement, skipped channels read 0
+ * \return  ESP_ERR_INVALID_STATE when pressure or humidity was skipped
+ */
+esp_err_t BME280_Compensate(const BME280_rawData_t *rawData, BME280_data_t *data);
+
+/** \brief  BME280 sensor read all trimming parameters in burst transactions
+ * \param calibData Trimming parameter storage
+ * \return  Bus status
+ */
+esp_err_t BME280_ReadTrimming(BME280_calibData_t *calibData);
+
 /** \brief  BME280 sensor calculate humadity data
- * \param rawHum Raw temperature data
- * \return  
+ * \param rawHum Raw humidity data
+ * \return  Humidity in %RH, Q22.10, needs t_fine of the same snapshot
  */
 int32_t BME280_CalculateHum(int32_t rawHum);
 
-/** \brief  BME280 sensor calculate press data
- * \param rawPress Raw temperature data
- * \return  
+/** \brief  BME280 sensor calculate press data with the BME280_PRESS_INT64 variant
+ * \param rawPress Raw pressure data
+ * \return  Pressure in Pa, Q24.8, needs t_fine of the same snapshot
  */
 int32_t BME280_CalculatePress(int32_t rawPress);
 
-/** \brief  BME280 sensor data filtering
- * \param bmeData Raw temperature data
- * \return Filtering data 
- */
-uint16_t bme280_median_filter(uint16_t bmeData);
\ No newline at end of file
+#endif /* BME280_H_ */
@@ -9,6 +9,14 @@
  *** INCLUDES
  ******************************************************************************/
 #include "bmp280Config.h"
+#include "i2cbus.h"
+
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    BMP280_BURST_READ_SIZE    6     /* 0xF7..0xFC */
+#define    BMP280_CHIP_ID            0x58  /* BMP280_ID_ADDR content */
 
 
 /******************************************************************************
@@ -44,13 +52,17 @@ typedef enum{
     BMP280_HUM_LSB_ADDR    = 0xFE
 }BMP280_registerAddr_e;
 
+/** @enum BMP280_calibrationaddr_e
+*   @brief BMP280 trimming parameter addresses
+*/
 typedef enum{
     BMP280_CALIBRATION_TEMP1 = 0x88,
     BMP280_CALIBRATION_TEMP2,
     BMP280_CALIBRATION_TEMP3,
     BMP280_CALIBRATION_TEMP4,
     BMP280_CALIBRATION_TEMP5,
-    BMP280_CALIBRATION_TEMP6
+    BMP280_CALIBRATION_TEMP6,
+    BMP280_CALIBRATION_PRESS1
 
 }BMP280_calibrationaddr_e;
 
@@ -138,6 +150,7 @@ typedef union{
     struct 
     {
         uint8_t spi3w_en_u1: 1;
+        uint8_t reserved_u1: 1;
         uint8_t filter_u3  : 3;
         uint8_t t_sb_u3    : 3;
     }bit;
@@ -250,16 +263,48 @@ typedef union{
     
     uint8_t u8;
 }BMP280_registerhum_lsb_t;
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct BMP280_rawData_t
+*   @brief BMP280 uncompensated measurement snapshot (0xF7..0xFC)
+*/
+typedef struct{
+
+    int32_t press_s32;   /* 20 bit pressure    */
+    int32_t temp_s32;    /* 20 bit temperature */
+}BMP280_rawData_t;
+
+/** @struct BMP280_calibData_t
+*   @brief BMP280 trimming parameters, read once from NVM at initialize
+*/
+typedef struct{
+
+    uint16_t dig_T1;
+    int16_t  dig_T2;
+    int16_t  dig_T3;
+    uint16_t dig_P1;
+    int16_t  dig_P2;
+    int16_t  dig_P3;
+    int16_t  dig_P4;
+    int16_t  dig_P5;
+    int16_t  dig_P6;
+    int16_t  dig_P7;
+    int16_t  dig_P8;
+    int16_t  dig_P9;
+}BMP280_calibData_t;
+
 
 /******************************************************************************
  *** FUNCTION PROTOTYPES
  ******************************************************************************/
 
 /** \brief  BMP280 sensor initialize function
- * \param[] Nothing
+ * \param dev I2C device handle of the sensor
  * \return  Nothing
  */
-void BMP280_Init(void);
+void BMP280_Init(I2CBUS_device_t *dev);
 
 /** \brief  BMP280 sensor reset disable or enable function
  * \param resetMode Enable or Disable
@@ -270,7 +315,7 @@ void BMP280_Init(void);
  * \param[] Nothing
  * \return  Nothing
  */
-void BME280_ctrlmeasInit (void);
+void BMP280_ctrlmeasInit (void);
 
 /** \brief  BMP280 sensor config register initalize global function
  * \param[] Nothing
@@ -288,16 +333,16 @@ void BMP280_reset(BMP280_resetmode_e resetMode);
  * \param reg_addr register address
  * \param data receive data buffer
  * \param len data size
- * \return  
+ * \return  Bus status
  */
-int16_t bmp280_register_read(BMP280_registerAddr_e reg_addr, uint8_t *data, size_t len);
+esp_err_t bmp280_register_read(BMP280_registerAddr_e reg_addr, uint8_t *data, size_t len);
 
 /** \brief  BME280 sensor write to register function
  * \param reg_addr register address
  * \param data transmit data buffer
- * \return  
+ * \return  Bus status
  */
-int16_t bmp280_register_write(BMP280_registerAddr_e reg_addr, uint8_t data);
+esp_err_t bmp280_register_write(BMP280_registerAddr_e reg_addr, uint8_t data);
 
 /** \brief  BME280 sensor calculate temperature data
  * \param[]
@@ -305,14 +350,52 @@ int16_t bmp280_register_write(BMP280_registerAddr_e reg_addr, uint8_t data);
  */
 int32_t BMP280_CalculateTemp(void);
 
-/** \brief  BMP280 sensor calculate press data
- * \param rawPress Raw temperature data
- * \return  
+/** \brief  BMP280 sensor read all data registers in one burst transaction
+ * \param rawData Uncompensated measurement snapshot
+ * \return  Bus status
  */
-int32_t BMP280_CalculatePress(int32_t rawPress);
+esp_err_t BMP280_ReadRawData(BMP280_rawData_t *rawData);
+
+/** \brief  BMP280 sensor datasheet maximum measurement time of the selected oversampling
+ * \param[] Nothing
+ * \return  Conversion time in us
+ */
+uint32_t BMP280_MeasureTimeUs(void);
+
+/** \brief  BMP280 sensor write the operating mode, normal mode converts continuously
+ * \param modeStatus Operating mode selection
+ * \return  Bus status
+ */
+esp_err_t BMP280_SetMode(BMP280_modestatus_e modeStatus);
+
+/** \brief  BMP280 sensor one-shot forced mode measurement: trigger, wait the maximum
+ *          measurement time, confirm the measuring bit is clear, then burst read
+ * \param rawData Uncompensated measurement snapshot
+ * \return  Bus status, ESP_ERR_TIMEOUT when the conversion does not finish
+ */
+esp_err_t BMP280_ReadForced(BMP280_rawData_t *rawData);
 
-/** \brief  BMP280 sensor data filtering
- * \param bmPData Raw temperature data
- * \return Filtering data 
+/** \brief  BMP280 sensor decode a burst of the data registers
+ * \param burst BMP280_BURST_READ_SIZE bytes read from 0xF7..0xFC
+ * \param rawData Uncompensated measurement snapshot
+ * \return  Nothing
+ */
+void BMP280_DecodeRawData(const uint8_t *burst, BMP280_rawData_t *rawData);
+
+/** \brief  BMP280 sensor temperature compensation
+ * \param adc_T Raw temperature data
+ * \return  Temperature in 0.01 DegC
+ */
+int32_t BMP280_compensate_T_int32(int32_t adc_T);
+
+/** \brief  BMP280 sensor read all trimming parameters in burst transactions
+ * \param calibData Trimming parameter storage
+ * \return  Bus status
+ */
+esp_err_t BMP280_ReadTrimming(BMP280_calibData_t *calibData);
+
+/** \brief  BMP280 sensor calculate press data with the BME280_PRESS_INT64 variant
+ * \param rawPress Raw pressure data
+ * \return  Pressure in Pa, Q24.8, needs t_fine of the same snapshot
  */
-uint16_t bmp280_median_filter(uint16_t bmpData);
+int32_t BMP280_CalculatePress(int32_t rawPress);
@@ -0,0 +1,242 @@
+/**
+ * \file bmx280.h
+ * \author Ugurcan OZTURK
+ * \brief	BME280/BMP280 Shared Driver Core Header File
+ * \date 17.10.2026
+ *
+ * One driver core for both parts. Every sensor has its own BMX280_t context,
+ * so any number of them can share or split the I2C ports. The BMP280 register
+ * map is the BME280 map without humidity, the BME280 register types are used
+ * for both.
+ */
+
+#ifndef BMX280_H_
+#define BMX280_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "bme280.h"
+#include "i2cbus.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    BMX280_ADDR_PRIMARY       0x76  /* SDO to GND */
+#define    BMX280_ADDR_SECONDARY     0x77  /* SDO to VDDIO */
+#define    BMX280_CHIP_ID_BME280     0x60
+#define    BMX280_CHIP_ID_BMP280     0x58
+#define    BMX280_BURST_READ_SIZE    8     /* 0xF7..0xFE, a BMP280 has no humidity bytes */
+#define    BMX280_BURST_NO_HUM_SIZE  6     /* 0xF7..0xFC */
+#define    BMX280_DIRTY_CTRL_HUM     0x01  /* Shadow registers not written yet */
+#define    BMX280_DIRTY_CONFIG       0x02
+#define    BMX280_DIRTY_CTRL_MEAS    0x04
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct BMX280_config_t
+*   @brief BMx280 measurement settings
+*/
+typedef struct{
+
+    BME280_modestatus_e         mode;
+    BME280_temp_oversampling_e  tempOver;
+    BME280_press_oversampling_e pressOver;
+    BME280_hum_oversampling_e   humOver;     /* Ignored without humidity */
+    BME280_filtermode_e         filter;
+    BME280_standbymode_e        standby;     /* Normal mode only */
+}BMX280_config_t;
+
+/** @struct BMX280_t
+*   @brief BMx280 per-device context: bus, variant, trimming and the shadow
+*          registers. Setters change the shadows, BMX280_Flush() writes the
+*          dirty ones
+*/
+typedef struct{
+
+    I2CBUS_device_t            *dev;
+    uint8_t                     chipId_u8;
+    bool                        hasHum;      /* BME280, chip ID 0x60 */
+    BME280_calibData_t          calib;
+    BME280_registerctrlhum_t    ctrlHum;     /* Shadow registers */
+    BME280_registerCtrl_meas_t  ctrlMeas;
+    BME280_registerConfig_t     config;
+    uint8_t                     dirty_u8;    /* BMX280_DIRTY_x */
+    uint8_t                     measDev_u8;  /* ctrl_meas as last written, for the mode the part is in */
+    int32_t                     t_fine;      /* From the last BMX280_CompensateTemp */
+}BMX280_t;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Identify the part, read its trimming, load the shadows from the
+ *          control registers and write the settings that differ
+ * \param ctx Caller-owned context
+ * \param dev I2C device handle of the sensor
+ * \param config Measurement settings
+ * \return ESP_ERR_NOT_FOUND when the chip ID is neither BME280 nor BMP280
+ */
+esp_err_t BMX280_Init(BMX280_t *ctx, I2CBUS_device_t *dev, const BMX280_config_t *config);
+
+/** \brief  Update every shadow field from the settings and flush
+ * \param ctx Context
+ * \param config Measurement settings
+ * \return Bus status
+ */
+esp_err_t BMX280_SetConfig(BMX280_t *ctx, const BMX280_config_t *config);
+
+/** \brief  Write the operating mode with any pending shadows, ctrl_meas is
+ *          always written. Normal mode converts continuously, forced mode
+ *          converts once and the shadow returns to sleep
+ * \param ctx Context
+ * \param mode Operating mode selection
+ * \return Bus status
+ */
+esp_err_t BMX280_SetMode(BMX280_t *ctx, BME280_modestatus_e mode);
+
+/** \brief  Temperature oversampling shadow setter, written by the next flush
+ * \param ctx Context
+ * \param over Oversampling
+ * \return Nothing
+ */
+void BMX280_SetTempOversampling(BMX280_t *ctx, BME280_temp_oversampling_e over);
+
+/** \brief  Pressure oversampling shadow setter, written by the next flush
+ * \param ctx Context
+ * \param over Oversampling
+ * \return Nothing
+ */
+void BMX280_SetPressOversampling(BMX280_t *ctx, BME280_press_oversampling_e over);
+
+/** \brief  Humidity oversampling shadow setter, ignored without humidity
+ * \param ctx Context
+ * \param over Oversampling
+ * \return Nothing
+ */
+void BMX280_SetHumOversampling(BMX280_t *ctx, BME280_hum_oversampling_e over);
+
+/** \brief  IIR filter shadow setter, written by the next flush
+ * \param ctx Context
+ * \param filter Filter coefficient
+ * \return Nothing
+ */
+void BMX280_SetFilter(BMX280_t *ctx, BME280_filtermode_e filter);
+
+/** \brief  Normal mode standby shadow setter, written by the next flush
+ * \param ctx Context
+ * \param standby Standby time
+ * \return Nothing
+ */
+void BMX280_SetStandby(BMX280_t *ctx, BME280_standbymode_e standby);
+
+/** \brief  Write the dirty shadows in one transaction of register/data pairs.
+ *          ctrl_meas follows ctrl_hum so it latches, and a part in normal mode
+ *          is put to sleep first because config writes may be ignored there
+ * \param ctx Context
+ * \return Bus status, the shadows stay dirty on failure
+ */
+esp_err_t BMX280_Flush(BMX280_t *ctx);
+
+/** \brief  Soft reset, the part and the shadows return to the power-on values
+ * \param ctx Context
+ * \return Bus status
+ */
+esp_err_t BMX280_Reset(BMX280_t *ctx);
+
+/** \brief  Read the trimming parameters in burst transactions
+ * \param ctx Context, hasHum selects the humidity block
+ * \return Bus status
+ */
+esp_err_t BMX280_ReadTrimming(BMX280_t *ctx);
+
+/** \brief  Datasheet maximum measurement time of the written oversampling
+ * \param ctx Context
+ * \return Conversion time in us
+ */
+uint32_t BMX280_MeasureTimeUs(const BMX280_t *ctx);
+
+/** \brief  Data register burst length of the variant
+ * \param ctx Context
+ * \return BMX280_BURST_READ_SIZE or BMX280_BURST_NO_HUM_SIZE
+ */
+size_t BMX280_BurstSize(const BMX280_t *ctx);
+
+/** \brief  Read all data registers in one burst transaction
+ * \param ctx Context
+ * \param rawData Uncompensated measurement snapshot
+ * \return Bus status
+ */
+esp_err_t BMX280_ReadRawData(BMX280_t *ctx, BME280_rawData_t *rawData);
+
+/** \brief  Decode a burst of the data registers
+ * \param ctx Context
+ * \param burst BMX280_BurstSize() bytes read from 0xF7
+ * \param rawData Uncompensated snapshot, humidity reads skipped without humidity
+ * \return Nothing
+ */
+void BMX280_DecodeRawData(const BMX280_t *ctx, const uint8_t *burst, BME280_rawData_t *rawData);
+
+/** \brief  One-shot forced mode measurement: trigger, wait the maximum
+ *          measurement time, confirm the measuring bit is clear, then burst read
+ * \param ctx Context
+ * \param rawData Uncompensated measurement snapshot
+ * \return Bus status, ESP_ERR_TIMEOUT when the conversion does not finish
+ */
+esp_err_t BMX280_ReadForced(BMX280_t *ctx, BME280_rawData_t *rawData);
+
+/** \brief  Temperature compensation, updates the context t_fine
+ * \param ctx Context
+ * \param adc_T Raw temperature data
+ * \return Temperature in 0.01 DegC
+ */
+int32_t BMX280_CompensateTemp(BMX280_t *ctx, int32_t adc_T);
+
+/** \brief  Pressure compensation, 64 bit integer
+ * \param ctx Context, t_fine of the same snapshot
+ * \param adc_P Raw pressure data
+ * \return Pressure in Pa, Q24.8
+ */
+uint32_t BMX280_CompensatePress64(const BMX280_t *ctx, int32_t adc_P);
+
+/** \brief  Pressure compensation, 32 bit integer
+ * \param ctx Context, t_fine of the same snapshot
+ * \param adc_P Raw pressure data
+ * \return Pressure in Pa
+ */
+uint32_t BMX280_CompensatePress32(const BMX280_t *ctx, int32_t adc_P);
+
+/** \brief  Humidity compensation, 32 bit integer
+ * \param ctx Context, t_fine of the same snapshot
+ * \param adc_H Raw humidity data
+ * \return Humidity in %RH, Q22.10
+ */
+uint32_t BMX280_CompensateHum(const BMX280_t *ctx, int32_t adc_H);
+
+/** \brief  Compensate every channel of one snapshot, temperature first. The
+ *          context is only read, its t_fine is left alone
+ * \param ctx Context
+ * \param rawData Uncompensated measurement snapshot
+ * \param data Compensated measurement, skipped channels and a missing humidity read 0
+ * \return ESP_ERR_INVALID_STATE when a configured channel was skipped
+ */
+esp_err_t BMX280_Compensate(const BMX280_t *ctx, const BME280_rawData_t *rawData, BME280_data_t *data);
+
+/** \brief  Compensate an array of snapshots with the context calibration
+ * \param ctx Context
+ * \param rawData Uncompensated measurement snapshots
+ * \param data Compensated measurements, count entries
+ * \param count Number of snapshots
+ * \return Number of snapshots without a skipped channel
+ */
+size_t BMX280_CompensateBatch(const BMX280_t *ctx, const BME280_rawData_t *rawData, BME280_data_t *data, size_t count);
+
+#endif /* BMX280_H_ */
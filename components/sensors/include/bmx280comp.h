@@ -0,0 +1,215 @@
+/**
+ * \file bmx280comp.h
+ * \author Ugurcan OZTURK
+ * \brief	BME280/BMP280 Fixed-Point Compensation Kernels Header File
+ * \date 17.10.2026
+ *
+ * Bosch integer compensation as inline kernels without state: the trimming
+ * parameters come in by pointer and t_fine is passed from the temperature
+ * kernel to the pressure and humidity kernels, so any number of tasks can
+ * compensate with one calibration set. BMX280COMP_SPECIALIZE() builds
+ * kernels around a calibration known at compile time, the coefficients then
+ * fold into immediates.
+ */
+
+#ifndef BMX280COMP_H_
+#define BMX280COMP_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "bme280.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    BMX280COMP_HUM_MAX        419430400  /* 100 %RH in Q22.10 << 12 */
+
+/** \brief  Define <name>_calib from an initializer and <name>_Compensate() and
+ *          <name>_Batch() kernels specialized for it
+ * \param name Prefix of the generated objects
+ * \param hasHum BME280 humidity channel present
+ * \param ... BME280_calibData_t initializer
+ */
+#define    BMX280COMP_SPECIALIZE(name, hasHum, ...)                                                          \
+     static const BME280_calibData_t name##_calib = __VA_ARGS__;                                             \
+     static inline esp_err_t name##_Compensate(const BME280_rawData_t *rawData, BME280_data_t *data){        \
+          return BMX280COMP_Compensate(&name##_calib, (hasHum), rawData, data);                              \
+     }                                                                                                       \
+     static inline size_t name##_Batch(const BME280_rawData_t *rawData, BME280_data_t *data, size_t count){  \
+          return BMX280COMP_Batch(&name##_calib, (hasHum), rawData, data, count);                            \
+     }
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+/** \brief  Fine temperature shared by the pressure and humidity kernels
+ * \param c Trimming parameters
+ * \param adc_T Raw temperature data
+ * \return t_fine
+ */
+static inline int32_t BMX280COMP_TFine(const BME280_calibData_t *c, int32_t adc_T){
+
+     int32_t var1, var2;
+     var1 = ((((adc_T>>3) - ((int32_t)c->dig_T1<<1))) * ((int32_t)c->dig_T2)) >> 11;
+     var2 = (((((adc_T>>4) - ((int32_t)c->dig_T1)) * ((adc_T>>4) - ((int32_t)c->dig_T1)))  >> 12) * ((int32_t)c->dig_T3)) >> 14;
+     return var1 + var2;
+}
+
+/** \brief  Temperature from t_fine
+ * \param t_fine Fine temperature
+ * \return Temperature in 0.01 DegC
+ */
+static inline int32_t BMX280COMP_Temp(int32_t t_fine){
+
+     return (t_fine * 5 + 128) >> 8;
+}
+
+/** \brief  Pressure compensation, 64 bit integer
+ * \param c Trimming parameters
+ * \param t_fine Fine temperature of the same snapshot
+ * \param adc_P Raw pressure data
+ * \return Pressure in Pa, Q24.8
+ */
+static inline uint32_t BMX280COMP_Press64(const BME280_calibData_t *c, int32_t t_fine, int32_t adc_P){
+
+     int64_t var1, var2, p;
+     /* Datasheet formula, its left shifts of signed terms written as the
+        equal multiplications, a negative left shift is undefined */
+     var1 = ((int64_t)t_fine) - 128000;
+     var2 = var1 * var1 * (int64_t)c->dig_P6;
+     var2 = var2 + ((var1 * (int64_t)c->dig_P5) * 131072);
+     var2 = var2 + (((int64_t)c->dig_P4) * 34359738368LL);
+     var1 = ((var1 * var1 * (int64_t)c->dig_P3) >> 8) + ((var1 * (int64_t)c->dig_P2) * 4096);
+     var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)c->dig_P1) >> 33;
+     if(var1 == 0){
+          return 0; // avoid exception caused by division by zero
+     }
+     p = 1048576 - adc_P;
+     p = (((p * 2147483648LL) - var2) * 3125) / var1;
+     var1 = (((int64_t)c->dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+     var2 = (((int64_t)c->dig_P8) * p) >> 19;
+     p = ((p + var1 + var2) >> 8) + (((int64_t)c->dig_P7) * 16);
+     return (uint32_t)p;
+}
+
+/** \brief  Pressure compensation, 32 bit integer
+ * \param c Trimming parameters
+ * \param t_fine Fine temperature of the same snapshot
+ * \param adc_P Raw pressure data
+ * \return Pressure in Pa
+ */
+static inline uint32_t BMX280COMP_Press32(const BME280_calibData_t *c, int32_t t_fine, int32_t adc_P){
+
+     int32_t var1, var2;
+     uint32_t p;
+     var1 = (((int32_t)t_fine) >> 1) - (int32_t)64000;
+     var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t)c->dig_P6);
+     var2 = var2 + ((var1 * ((int32_t)c->dig_P5)) * 2);
+     var2 = (var2 >> 2) + (((int32_t)c->dig_P4) * 65536);
+     var1 = (((c->dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((((int32_t)c->dig_P2) * var1) >> 1)) >> 18;
+     var1 = ((((32768 + var1)) * ((int32_t)c->dig_P1)) >> 15);
+     if(var1 == 0){
+          return 0; // avoid exception caused by division by zero
+     }
+     p = (((uint32_t)(((int32_t)1048576) - adc_P) - (var2 >> 12))) * 3125;
+     if(p < 0x80000000){
+          p = (p << 1) / ((uint32_t)var1);
+     }else
+     {
+          p = (p / (uint32_t)var1) * 2;
+     }
+     var1 = (((int32_t)c->dig_P9) * ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
+     var2 = (((int32_t)(p >> 2)) * ((int32_t)c->dig_P8)) >> 13;
+     p = (uint32_t)((int32_t)p + ((var1 + var2 + c->dig_P7) >> 4));
+     return p;
+}
+
+/** \brief  Humidity compensation, 32 bit integer
+ * \param c Trimming parameters
+ * \param t_fine Fine temperature of the same snapshot
+ * \param adc_H Raw humidity data
+ * \return Humidity in %RH, Q22.10
+ */
+static inline uint32_t BMX280COMP_Hum(const BME280_calibData_t *c, int32_t t_fine, int32_t adc_H){
+
+     int32_t v_x1_u32r;
+     v_x1_u32r = (t_fine - ((int32_t)76800));
+     v_x1_u32r = (((((adc_H << 14) - (((int32_t)c->dig_H4) * 1048576) - (((int32_t)c->dig_H5) * v_x1_u32r)) +
+                  ((int32_t)16384)) >> 15) * (((((((v_x1_u32r * ((int32_t)c->dig_H6)) >> 10) *
+                  (((v_x1_u32r * ((int32_t)c->dig_H3)) >> 11) + ((int32_t)32768))) >> 10) +
+                  ((int32_t)2097152)) * ((int32_t)c->dig_H2) + 8192) >> 14));
+     v_x1_u32r = (v_x1_u32r - (((((v_x1_u32r >> 15) * (v_x1_u32r >> 15)) >> 7) * ((int32_t)c->dig_H1)) >> 4));
+     v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
+     v_x1_u32r = (v_x1_u32r > BMX280COMP_HUM_MAX ? BMX280COMP_HUM_MAX : v_x1_u32r);
+     return (uint32_t)(v_x1_u32r >> 12);
+}
+
+/** \brief  Compensate every channel of one snapshot, temperature first
+ * \param c Trimming parameters
+ * \param hasHum BME280 humidity channel present
+ * \param rawData Uncompensated measurement snapshot
+ * \param data Compensated measurement, skipped channels and a missing humidity read 0
+ * \return ESP_ERR_INVALID_STATE when a configured channel was skipped
+ */
+static inline esp_err_t BMX280COMP_Compensate(const BME280_calibData_t *c, bool hasHum, const BME280_rawData_t *rawData, BME280_data_t *data){
+
+     int32_t t_fine = BMX280COMP_TFine(c, rawData->temp_s32);
+     esp_err_t status = ESP_OK;
+
+     data->temp_s32  = BMX280COMP_Temp(t_fine);
+     data->press_u32 = 0;
+     data->hum_u32   = 0;
+
+     if(rawData->press_s32 == BME280_PRESS_SKIPPED){
+          status = ESP_ERR_INVALID_STATE;
+     }else
+     {
+#if BME280_PRESS_INT64
+          data->press_u32 = BMX280COMP_Press64(c, t_fine, rawData->press_s32);
+#else
+          data->press_u32 = BMX280COMP_Press32(c, t_fine, rawData->press_s32) << 8;
+#endif
+     }
+     if(hasHum){
+          if(rawData->hum_s32 == BME280_HUM_SKIPPED){
+               status = ESP_ERR_INVALID_STATE;
+          }else
+          {
+               data->hum_u32 = BMX280COMP_Hum(c, t_fine, rawData->hum_s32);
+          }
+     }
+
+     return status;
+}
+
+/** \brief  Compensate an array of snapshots of one part
+ * \param c Trimming parameters
+ * \param hasHum BME280 humidity channel present
+ * \param rawData Uncompensated measurement snapshots
+ * \param data Compensated measurements, count entries
+ * \param count Number of snapshots
+ * \return Number of snapshots without a skipped channel
+ */
+static inline size_t BMX280COMP_Batch(const BME280_calibData_t *c, bool hasHum, const BME280_rawData_t *rawData, BME280_data_t *data, size_t count){
+
+     /* Local copy, the coefficients stay in registers across the output stores */
+     const BME280_calibData_t calib = *c;
+     size_t valid = 0;
+
+     for(size_t i = 0; i < count; i++){
+          if(BMX280COMP_Compensate(&calib, hasHum, &rawData[i], &data[i]) == ESP_OK){
+               valid++;
+          }
+     }
+
+     return valid;
+}
+
+#endif /* BMX280COMP_H_ */
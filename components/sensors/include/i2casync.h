@@ -0,0 +1,108 @@
+/**
+ * \file i2casync.h
+ * \author Ugurcan OZTURK
+ * \brief	I2C Asynchronous Transaction Engine Header File
+ * \date 17.10.2026
+ */
+
+#ifndef I2CASYNC_H_
+#define I2CASYNC_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "i2cbus.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    I2CASYNC_QUEUE_LEN        16
+
+
+/******************************************************************************
+ *** ENUMS
+ ******************************************************************************/
+
+/** @enum I2CASYNC_op_e
+*   @brief Queued transaction type
+*/
+typedef enum{
+    I2CASYNC_OP_READ,         /* Burst read starting at reg  */
+    I2CASYNC_OP_WRITE         /* Burst write starting at reg */
+}I2CASYNC_op_e;
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+typedef struct I2CASYNC_trans_s I2CASYNC_trans_t;
+
+/** \brief  Completion callback, runs in the bus owner task context
+ * \param trans Completed transaction, status is valid
+ * \param arg User argument of the transaction
+ */
+typedef void (*I2CASYNC_callback_t)(I2CASYNC_trans_t *trans, void *arg);
+
+/** @struct I2CASYNC_trans_t
+*   @brief Transaction descriptor, owned by the caller until completion
+*/
+struct I2CASYNC_trans_s{
+
+    I2CBUS_device_t    *dev;
+    I2CASYNC_op_e       op;
+    uint8_t             reg;
+    uint8_t            *data;
+    size_t              len;
+    bool                urgent;        /* Queue in front of pending transactions */
+    I2CASYNC_callback_t callback;      /* May be NULL */
+    void               *arg;
+    SemaphoreHandle_t   done;          /* Given on completion, may be NULL */
+    esp_err_t           status;        /* Set by the bus owner task */
+};
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/*
+ * The engine has no task of its own. Each controller is owned by one task,
+ * the only one allowed to touch it, which executes the queued transactions
+ * with I2CASYNC_Service between its own transfers. Other tasks reach the
+ * bus through I2CASYNC_Submit and I2CASYNC_Transfer.
+ */
+
+/** \brief  Create the transaction queue of an I2C controller
+ * \param port Initialized I2C controller
+ * \param owner Task that calls I2CASYNC_Service for this controller, notified
+ *        with xTaskNotifyGive when a transaction is queued
+ * \return  ESP_OK, ESP_ERR_NO_MEM or ESP_ERR_INVALID_STATE when already created
+ */
+esp_err_t I2CASYNC_Init(i2c_port_t port, TaskHandle_t owner);
+
+/** \brief  Execute the queued transactions of a controller, owner task only
+ * \param port I2C controller
+ * \return  Number of executed transactions
+ */
+size_t I2CASYNC_Service(i2c_port_t port);
+
+/** \brief  Queue a transaction on the bus of its device
+ * \param trans Transaction descriptor, must stay valid until completion
+ * \param wait Ticks to wait for free queue space
+ * \return  ESP_OK when queued, ESP_ERR_TIMEOUT when the queue is full
+ */
+esp_err_t I2CASYNC_Submit(I2CASYNC_trans_t *trans, TickType_t wait);
+
+/** \brief  Queue a transaction and block the calling task until it completes
+ * \param trans Transaction descriptor, done is overwritten
+ * \return  Transaction status, ESP_ERR_INVALID_STATE from the owner task
+ */
+esp_err_t I2CASYNC_Transfer(I2CASYNC_trans_t *trans);
+
+#endif /* I2CASYNC_H_ */
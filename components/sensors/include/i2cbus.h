@@ -0,0 +1,259 @@
+/**
+ * \file i2cbus.h
+ * \author Ugurcan OZTURK
+ * \brief	I2C Bus Device Layer Header File
+ * \date 17.10.2026
+ */
+
+#ifndef I2CBUS_H_
+#define I2CBUS_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "driver/i2c.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    I2CBUS_HIST_BUCKETS       16    /* Bucket n counts [2^n, 2^(n+1)) us */
+#define    I2CBUS_PROBE_READS        4     /* Chip-ID reads per device at each probed speed */
+#define    I2CBUS_ADAPT_WINDOW       32    /* Transactions per runtime error-rate window */
+#define    I2CBUS_RETRY_MAX          3     /* Retries after the first failed attempt */
+#define    I2CBUS_BACKOFF_US         1000  /* First retry delay, doubled on each retry */
+#define    I2CBUS_QUARANTINE_FAILS   3     /* Consecutive failed calls before quarantine */
+#define    I2CBUS_QUARANTINE_MS      5000  /* Calls to a quarantined device fail at once */
+#define    I2CBUS_CLEAR_CLOCKS       9     /* SCL pulses of a bus clear */
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct I2CBUS_busConfig_t
+*   @brief I2C controller pin and clock configuration
+*/
+typedef struct{
+
+    i2c_port_t port;
+    int        sdaIo;
+    int        sclIo;
+    uint32_t   clkSpeed;      /* SCL frequency (Hz) */
+}I2CBUS_busConfig_t;
+
+/** @struct I2CBUS_stats_t
+*   @brief Per device transaction counters
+*/
+typedef struct{
+
+    uint32_t   transCount;
+    uint32_t   bytesOut;      /* Register address and data bytes written */
+    uint32_t   bytesIn;
+    uint32_t   minUs;
+    uint32_t   maxUs;
+    uint64_t   totalUs;
+    uint32_t   hist[I2CBUS_HIST_BUCKETS];
+    uint32_t   nackCount;     /* ESP_FAIL, address or data not acknowledged */
+    uint32_t   timeoutCount;  /* ESP_ERR_TIMEOUT */
+    uint32_t   busErrCount;   /* Arbitration loss and other bus state errors */
+    uint32_t   retryCount;
+    uint32_t   busClearCount; /* Bus clear and driver reinstall */
+    uint32_t   quarantineCount;
+    uint32_t   maxRecoverUs;  /* Longest time from a first failure to the call result */
+}I2CBUS_stats_t;
+
+/** @struct I2CBUS_device_t
+*   @brief I2C slave device handle
+*/
+typedef struct{
+
+    i2c_port_t     port;
+    uint8_t        addr;      /* 7 bit slave address */
+    uint32_t       clkSpeed;  /* Highest SCL frequency the device accepts (Hz) */
+    uint32_t       timeoutMs; /* Transaction timeout (ms) */
+    I2CBUS_stats_t stats;     /* Updated by every bus call, read with I2CBUS_GetStats */
+    uint32_t       failStreak;          /* Consecutive failed calls */
+    int64_t        quarantineUntilUs;   /* esp_timer time the quarantine ends */
+}I2CBUS_device_t;
+
+/** @struct I2CBUS_probe_t
+*   @brief Identification register checked by the clock probe
+*/
+typedef struct{
+
+    I2CBUS_device_t *dev;
+    uint8_t          idReg;
+    uint8_t          idValue; /* Expected register content */
+}I2CBUS_probe_t;
+
+/** @struct I2CBUS_batchRead_t
+*   @brief One register block read of a batched transaction
+*/
+typedef struct{
+
+    I2CBUS_device_t *dev;
+    uint8_t          reg;     /* First register address */
+    uint8_t         *data;
+    size_t           len;
+    esp_err_t        status;  /* Result of this block, set by I2CBUS_BatchRead */
+}I2CBUS_batchRead_t;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  I2C master controller initialize function
+ * \param busConf Controller configuration
+ * \return  Driver status
+ */
+esp_err_t I2CBUS_Init(const I2CBUS_busConfig_t *busConf);
+
+/*
+ * Every transfer function below retries NACKs, timeouts and bus state errors
+ * up to I2CBUS_RETRY_MAX times with exponential backoff, 1, 2 then 4 ms.
+ * A backoff shorter than a tick is busy waited, longer ones sleep rounded up
+ * to whole ticks. Timeouts and bus state errors clear the bus and reinstall
+ * the driver before the retry, about 100 us of SCL pulses. A call therefore
+ * blocks at most (I2CBUS_RETRY_MAX + 1) * timeoutMs + 7 ms plus three bus
+ * clears, 87 ms with a 20 ms timeout.
+ * A device failing I2CBUS_QUARANTINE_FAILS calls in a row is quarantined:
+ * its calls return ESP_ERR_INVALID_STATE without bus traffic for
+ * I2CBUS_QUARANTINE_MS, then a single failure quarantines it again.
+ * Recovery reconfigures the controller, so each controller must be used
+ * from one task at a time.
+ */
+
+/** \brief  I2C single register read function
+ * \param dev Device handle
+ * \param reg Register address
+ * \param data Receive data
+ * \return  Bus status
+ */
+esp_err_t I2CBUS_Read(I2CBUS_device_t *dev, uint8_t reg, uint8_t *data);
+
+/** \brief  I2C single register write function
+ * \param dev Device handle
+ * \param reg Register address
+ * \param data Transmit data
+ * \return  Bus status
+ */
+esp_err_t I2CBUS_Write(I2CBUS_device_t *dev, uint8_t reg, uint8_t data);
+
+/** \brief  I2C auto-increment multi register read function
+ * \param dev Device handle
+ * \param reg First register address
+ * \param data Receive data buffer
+ * \param len Receive data size
+ * \return  Bus status
+ */
+esp_err_t I2CBUS_BurstRead(I2CBUS_device_t *dev, uint8_t reg, uint8_t *data, size_t len);
+
+/** \brief  I2C auto-increment multi register write function
+ * \param dev Device handle
+ * \param reg First register address
+ * \param data Transmit data buffer
+ * \param len Transmit data size
+ * \return  Bus status
+ */
+esp_err_t I2CBUS_BurstWrite(I2CBUS_device_t *dev, uint8_t reg, const uint8_t *data, size_t len);
+
+/** \brief  I2C raw write then repeated-start read function
+ * \param dev Device handle
+ * \param txData Transmit data buffer
+ * \param txLen Transmit data size
+ * \param rxData Receive data buffer
+ * \param rxLen Receive data size
+ * \return  Bus status
+ */
+esp_err_t I2CBUS_WriteRead(I2CBUS_device_t *dev, const uint8_t *txData, size_t txLen, uint8_t *rxData, size_t rxLen);
+
+/** \brief  I2C batched read, all blocks in one command link with repeated starts
+ *          Quarantined devices are skipped. When the batch fails every block is
+ *          read on its own, so one failing device does not invalidate the others
+ * \param reads Register block list, every device must be on the same controller
+ * \param count Number of blocks
+ * \return  ESP_OK when every block status is ESP_OK, else the first failed block status
+ */
+esp_err_t I2CBUS_BatchRead(I2CBUS_batchRead_t *reads, size_t count);
+
+/** \brief  I2C chained read, as I2CBUS_BatchRead without the per-block fallback.
+ *          For reads with side effects, e.g. FIFO entries that pop when read:
+ *          a failed chain is not read again and every block gets its status
+ * \param reads Register block list, every device must be on the same controller
+ * \param count Number of blocks
+ * \return  ESP_OK when every block status is ESP_OK, else the first failed block status
+ */
+esp_err_t I2CBUS_ChainRead(I2CBUS_batchRead_t *reads, size_t count);
+
+/** \brief  Clock SCL until a slave holding SDA low releases it, send a STOP and
+ *          reinstall the driver with the current configuration
+ * \param port Initialized I2C controller
+ * \return  Driver status
+ */
+esp_err_t I2CBUS_RecoverBus(i2c_port_t port);
+
+/** \brief  Consistent copy of the transaction counters of a device
+ * \param dev Device handle
+ * \param snapshot Counter copy
+ * \return  Nothing
+ */
+void I2CBUS_GetStats(I2CBUS_device_t *dev, I2CBUS_stats_t *snapshot);
+
+/** \brief  Clear the transaction counters of a device
+ * \param dev Device handle
+ * \return  Nothing
+ */
+void I2CBUS_ResetStats(I2CBUS_device_t *dev);
+
+/** \brief  Average transaction latency of a counter snapshot
+ * \param snapshot Counter copy
+ * \return  Latency (us)
+ */
+uint32_t I2CBUS_AvgLatencyUs(const I2CBUS_stats_t *snapshot);
+
+/** \brief  Select the fastest SCL frequency of 400 kHz, 700 kHz and 1 MHz with
+ *          error free chip-ID reads, limited by the clkSpeed of every device
+ * \param port Initialized I2C controller
+ * \param probes Identification register of each device on the bus
+ * \param count Number of devices
+ * \return  ESP_OK, or ESP_ERR_NOT_FOUND when 400 kHz fails and the bus falls back to 100 kHz
+ */
+esp_err_t I2CBUS_ProbeClock(i2c_port_t port, const I2CBUS_probe_t *probes, size_t count);
+
+/** \brief  Single attempt register read for address scans, an absent device
+ *          NACKs without retries, bus recovery, statistics or quarantine
+ * \param port Initialized I2C controller
+ * \param addr 7 bit slave address
+ * \param reg Register address
+ * \param data Register content
+ * \param timeoutMs Transaction timeout (ms)
+ * \return  Driver status, ESP_FAIL when no device acknowledges
+ */
+esp_err_t I2CBUS_ProbeAddr(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t *data, uint32_t timeoutMs);
+
+/** \brief  Reprogram the SCL frequency between transactions
+ * \param port Initialized I2C controller
+ * \param clkSpeed SCL frequency (Hz)
+ * \return  Driver status
+ */
+esp_err_t I2CBUS_SetClock(i2c_port_t port, uint32_t clkSpeed);
+
+/** \brief  Current SCL frequency of a controller
+ * \param port I2C controller
+ * \return  SCL frequency (Hz)
+ */
+uint32_t I2CBUS_GetClock(i2c_port_t port);
+
+/** \brief  Step the clock down one speed when NACKs and timeouts of a window
+ *          of I2CBUS_ADAPT_WINDOW transactions exceed a rate
+ * \param port I2C controller
+ * \param maxErrPermille Highest tolerated error rate (1/1000), 0 disables
+ * \return  Nothing
+ */
+void I2CBUS_SetAdaptive(i2c_port_t port, uint32_t maxErrPermille);
+
+#endif /* I2CBUS_H_ */
@@ -0,0 +1,126 @@
+/**
+ * \file medfilt.h
+ * \author Ugurcan OZTURK
+ * \brief	Running Median Filter Header File
+ * \date 17.10.2026
+ *
+ * Running median over the last window samples of one channel. State and
+ * sample storage are owned by the caller, so any number of channels can be
+ * filtered. Samples are kept as order-preserving 32 bit keys, one code path
+ * serves signed and unsigned 16 and 32 bit data. Full 3, 5, 7 and 9 sample
+ * windows use branchless selection networks, larger windows and the warm-up
+ * keep a sorted copy of the window next to the arrival-order ring.
+ */
+
+#ifndef MEDFILT_H_
+#define MEDFILT_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    MEDFILT_WINDOW_MAX        1023  /* Odd */
+#define    MEDFILT_NETWORK_MAX       9     /* Largest window with a selection network */
+#define    MEDFILT_STORAGE_WORDS(window)  (2 * (window))  /* Ring and sorted copy */
+
+
+/******************************************************************************
+ *** ENUMS
+ ******************************************************************************/
+
+/** @enum MEDFILT_type_e
+*   @brief Sample type of the block API
+*/
+typedef enum{
+    MEDFILT_TYPE_S16,
+    MEDFILT_TYPE_U16,
+    MEDFILT_TYPE_S32,
+    MEDFILT_TYPE_U32
+}MEDFILT_type_e;
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct MEDFILT_t
+*   @brief Caller-owned filter of one channel
+*/
+typedef struct{
+
+    MEDFILT_type_e     type;
+    uint16_t           window_u16;
+    uint16_t           count_u16;    /* Samples in the window, window after warm-up */
+    uint16_t           oldest_u16;   /* Ring slot replaced by the next sample */
+    uint32_t          *ring;         /* Window keys in arrival order */
+    uint32_t          *sorted;       /* Window keys ascending, unused by a full network window */
+}MEDFILT_t;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Set up an empty filter
+ * \param filt Caller-owned filter
+ * \param type Sample type of MEDFILT_Block
+ * \param storage Caller storage, MEDFILT_STORAGE_WORDS(window) words, kept by reference
+ * \param window Odd window length, 1..MEDFILT_WINDOW_MAX
+ * \return ESP_ERR_INVALID_ARG for an even or unsupported window
+ */
+esp_err_t MEDFILT_Init(MEDFILT_t *filt, MEDFILT_type_e type, uint32_t *storage, uint16_t window);
+
+/** \brief  Drop every sample, e.g. after a gap in the stream
+ * \param filt Filter
+ * \return Nothing
+ */
+void MEDFILT_Reset(MEDFILT_t *filt);
+
+/** \brief  Add one sample. Until the window fills the median of the samples
+ *          so far is returned, the lower middle one for an even count
+ * \param filt Filter
+ * \param x Sample
+ * \return Median of the window
+ */
+int16_t MEDFILT_PutS16(MEDFILT_t *filt, int16_t x);
+
+/** \brief  Add one sample, see MEDFILT_PutS16
+ * \param filt Filter
+ * \param x Sample
+ * \return Median of the window
+ */
+uint16_t MEDFILT_PutU16(MEDFILT_t *filt, uint16_t x);
+
+/** \brief  Add one sample, see MEDFILT_PutS16
+ * \param filt Filter
+ * \param x Sample
+ * \return Median of the window
+ */
+int32_t MEDFILT_PutS32(MEDFILT_t *filt, int32_t x);
+
+/** \brief  Add one sample, see MEDFILT_PutS16
+ * \param filt Filter
+ * \param x Sample
+ * \return Median of the window
+ */
+uint32_t MEDFILT_PutU32(MEDFILT_t *filt, uint32_t x);
+
+/** \brief  Filter an array of the filter type in one call, in and out may be
+ *          the same array
+ * \param filt Filter
+ * \param in Samples
+ * \param out Medians, same layout as in
+ * \param count Number of samples
+ * \param stride Distance between samples in elements, e.g. 3 for one axis of
+ *        interleaved x, y, z data
+ * \return Nothing
+ */
+void MEDFILT_Block(MEDFILT_t *filt, const void *in, void *out, size_t count, size_t stride);
+
+#endif /* MEDFILT_H_ */
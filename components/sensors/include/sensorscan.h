@@ -0,0 +1,119 @@
+/**
+ * \file sensorscan.h
+ * \author Ugurcan OZTURK
+ * \brief	Boot-Time Sensor Enumeration Header File
+ * \date 17.10.2026
+ *
+ * Scans the BMx280 and ADXL345 addresses of every I2C port, classifies each
+ * answering part by its chip ID and keeps the result in NVS. Every boot reads
+ * the chip ID of every candidate address, which confirms the cached parts and
+ * finds parts added or moved since, at the cost of one NACK per empty
+ * address. NVS is rewritten only when the result changes. Ports are scanned
+ * in parallel, one task per port. nvs_flash_init() must run first.
+ */
+
+#ifndef SENSORSCAN_H_
+#define SENSORSCAN_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "i2cbus.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    SENSORSCAN_PORT_PARTS     4     /* Candidate addresses of one port */
+#define    SENSORSCAN_PARTS_MAX      (SENSORSCAN_PORT_PARTS * I2C_NUM_MAX)
+#define    SENSORSCAN_TIMEOUT_MS     20    /* Chip-ID read timeout (ms) */
+#define    SENSORSCAN_TASK_STACK     2048
+#define    SENSORSCAN_TASK_PRIORITY  (configMAX_PRIORITIES - 3)
+#define    SENSORSCAN_NVS_NAMESPACE  "sensorscan"
+#define    SENSORSCAN_NVS_KEY        "parts"
+#define    SENSORSCAN_VERSION        1     /* Cached layout version, older blobs are rescanned */
+
+
+/******************************************************************************
+ *** ENUMS
+ ******************************************************************************/
+
+/** @enum SENSORSCAN_part_e
+*   @brief Part classified by its chip ID
+*/
+typedef enum{
+    SENSORSCAN_PART_NONE,
+    SENSORSCAN_PART_BME280,   /* 0xD0 reads 0x60 */
+    SENSORSCAN_PART_BMP280,   /* 0xD0 reads 0x58 */
+    SENSORSCAN_PART_ADXL345   /* 0x00 reads 0xE5 */
+}SENSORSCAN_part_e;
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct SENSORSCAN_entry_t
+*   @brief One discovered part
+*/
+typedef struct{
+
+    uint8_t            port_u8;
+    uint8_t            addr_u8;  /* 7 bit slave address */
+    uint8_t            part_u8;  /* SENSORSCAN_part_e */
+    uint8_t            taken_u8; /* Claimed by SENSORSCAN_Take, not cached */
+}SENSORSCAN_entry_t;
+
+/** @struct SENSORSCAN_result_t
+*   @brief Caller-owned enumeration result, stored in NVS as one blob
+*/
+typedef struct{
+
+    uint8_t            version_u8;
+    uint8_t            count_u8;
+    uint8_t            portMask_u8;    /* Ports the result covers */
+    bool               fromCache;      /* Same parts as the NVS copy, nothing was written */
+    SENSORSCAN_entry_t entries[SENSORSCAN_PARTS_MAX];
+}SENSORSCAN_result_t;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Enumerate the parts of initialized I2C controllers. Every
+ *          candidate address is identified and a result that differs from
+ *          the cached one is written back to NVS
+ * \param ports Initialized I2C controllers
+ * \param count Number of controllers
+ * \param result Parts in port and address order
+ * \return ESP_ERR_INVALID_ARG for more than I2C_NUM_MAX controllers. NVS
+ *         errors are not fatal, they only cost a rewrite on the next boot
+ */
+esp_err_t SENSORSCAN_Discover(const i2c_port_t *ports, size_t count, SENSORSCAN_result_t *result);
+
+/** \brief  Scan the candidate addresses of one controller, no cache
+ * \param port Initialized I2C controller
+ * \param entries At least SENSORSCAN_PORT_PARTS entries
+ * \return Number of parts found
+ */
+size_t SENSORSCAN_ScanPort(i2c_port_t port, SENSORSCAN_entry_t *entries);
+
+/** \brief  Claim the first unclaimed part of a kind
+ * \param result Enumeration result
+ * \param part Part kind
+ * \param dev Device handle, port and addr are set from the part
+ * \return ESP_ERR_NOT_FOUND when every part of the kind is claimed
+ */
+esp_err_t SENSORSCAN_Take(SENSORSCAN_result_t *result, SENSORSCAN_part_e part, I2CBUS_device_t *dev);
+
+/** \brief  Drop the cached result, the next boot writes its result again
+ * \return NVS status
+ */
+esp_err_t SENSORSCAN_Forget(void);
+
+#endif /* SENSORSCAN_H_ */
@@ -0,0 +1,119 @@
+/**
+ * \file spectrum.h
+ * \author Ugurcan OZTURK
+ * \brief	Fixed-Point Vibration Spectrum Header File
+ * \date 17.10.2026
+ */
+
+#ifndef SPECTRUM_H_
+#define SPECTRUM_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    SPECTRUM_SIZE_MAX         1024  /* Largest FFT size, sets the static buffers */
+#define    SPECTRUM_BANDS_MAX        8
+#define    SPECTRUM_AXES             3     /* x, y, z interleaved as ADXL_sample_t */
+#define    SPECTRUM_ENERGY_FRAC_BITS 8     /* Band energy unit is 2^-8 LSB^2 */
+
+
+/******************************************************************************
+ *** ENUMS
+ ******************************************************************************/
+
+   /** @enum SPECTRUM_size_e
+   *   @brief FFT block size in samples
+   */
+typedef enum {
+
+     SPECTRUM_SIZE_256  = 256,
+     SPECTRUM_SIZE_512  = 512,
+     SPECTRUM_SIZE_1024 = 1024
+
+}SPECTRUM_size_e;
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct SPECTRUM_config_t
+*   @brief Block size, sample rate and band edges
+*/
+typedef struct{
+
+    SPECTRUM_size_e size;
+    uint16_t        sampleRateHz_u16;
+    uint8_t         bandCount_u8;
+    uint16_t        bandEdgesHz_u16[SPECTRUM_BANDS_MAX + 1];   /* Band b is [edge b, edge b+1) */
+}SPECTRUM_config_t;
+
+/** @struct SPECTRUM_features_t
+*   @brief Spectral features of one axis block
+*/
+typedef struct{
+
+    uint32_t   bandEnergy_u32[SPECTRUM_BANDS_MAX];   /* Sum of |X[k]|^2, 2^-8 LSB^2, saturated */
+    uint16_t   peakDeciHz_u16;                       /* Dominant bin frequency, 0.1 Hz */
+    uint16_t   peakAmp_u16;                          /* Dominant sine amplitude estimate, LSB */
+}SPECTRUM_features_t;
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Build the Hann window and twiddle tables and clear the block
+ * \param config Block size, sample rate and bands, kept by reference
+ * \return ESP_ERR_INVALID_ARG for an unsupported size or band table
+ */
+esp_err_t SPECTRUM_Init(const SPECTRUM_config_t *config);
+
+/** \brief  Drop the partly filled block, e.g. after a FIFO overrun gap
+ * \param[] Nothing
+ * \return Nothing
+ */
+void SPECTRUM_Reset(void);
+
+/** \brief  Append samples to the block
+ * \param xyz Samples, x, y, z interleaved
+ * \param count Number of x, y, z samples
+ * \return Samples taken, less than count when the block fills
+ */
+size_t SPECTRUM_Feed(const int16_t *xyz, size_t count);
+
+/** \brief  Block holds config size samples per axis
+ * \param[] Nothing
+ * \return Block full
+ */
+bool SPECTRUM_Ready(void);
+
+/** \brief  Analyze every axis of a full block and start a new one
+ * \param features SPECTRUM_AXES results
+ * \return ESP_ERR_INVALID_STATE when the block is not full
+ */
+esp_err_t SPECTRUM_Process(SPECTRUM_features_t *features);
+
+/** \brief  Band energies and peak of one axis: mean removal, Hann window, FFT
+ * \param samples Config size samples
+ * \param stride Distance between samples, SPECTRUM_AXES for an interleaved block
+ * \param features Axis result
+ * \return Nothing
+ */
+void SPECTRUM_Analyze(const int16_t *samples, size_t stride, SPECTRUM_features_t *features);
+
+/** \brief  In-place radix-2 FFT, Q15 with 1/2 scaling per stage so the output
+ *          is X[k]/size, inputs must stay within +-2^14
+ * \param data Complex data, real and imaginary interleaved
+ * \param size SPECTRUM_size_e, tables come from SPECTRUM_Init
+ * \return Nothing
+ */
+void SPECTRUM_Fft(int16_t *data, uint16_t size);
+
+#endif /* SPECTRUM_H_ */
@@ -0,0 +1,106 @@
+/**
+ * \file vibfeat.h
+ * \author Ugurcan OZTURK
+ * \brief	Time-Domain Vibration Features Header File
+ * \date 17.10.2026
+ */
+
+#ifndef VIBFEAT_H_
+#define VIBFEAT_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    VIBFEAT_AXES              3     /* x, y, z interleaved as ADXL_sample_t */
+#define    VIBFEAT_WINDOW_MAX        2048  /* Fourth power sums of 13 bit samples stay in 64 bits */
+#define    VIBFEAT_Q8_ONE            256   /* Crest factor and kurtosis unit */
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct VIBFEAT_accum_t
+*   @brief Power sums of one axis, taken about the first sample of the window
+*          so the gravity offset does not cancel out the small vibration terms
+*/
+typedef struct{
+
+    int16_t    offset_s16;
+    int16_t    min_s16;
+    int16_t    max_s16;
+    int64_t    sum1_s64;
+    uint64_t   sum2_u64;
+    int64_t    sum3_s64;
+    uint64_t   sum4_u64;
+}VIBFEAT_accum_t;
+
+/** @struct VIBFEAT_window_t
+*   @brief Caller-owned streaming window, x, y, z accumulators
+*/
+typedef struct{
+
+    uint16_t          window_u16;    /* Samples per window */
+    uint16_t          count_u16;     /* Samples in the current window */
+    VIBFEAT_accum_t   axis[VIBFEAT_AXES];
+}VIBFEAT_window_t;
+
+/** @struct VIBFEAT_features_t
+*   @brief Time-domain features of one axis window
+*/
+typedef struct{
+
+    int16_t    mean_s16;             /* LSB */
+    uint16_t   rms_u16;              /* RMS about the mean, LSB */
+    uint16_t   peakToPeak_u16;       /* LSB */
+    uint16_t   crestQ8_u16;          /* Peak about the mean over RMS, Q8 */
+    uint16_t   kurtosisQ8_u16;       /* m4 / m2^2, 3.0 for Gaussian noise, Q8 */
+}VIBFEAT_features_t;
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Set the window length and start an empty window
+ * \param win Caller-owned window
+ * \param window Samples per window, 2..VIBFEAT_WINDOW_MAX
+ * \return ESP_ERR_INVALID_ARG for an unsupported window
+ */
+esp_err_t VIBFEAT_Init(VIBFEAT_window_t *win, uint16_t window);
+
+/** \brief  Drop the partly filled window
+ * \param win Window
+ * \return Nothing
+ */
+void VIBFEAT_Reset(VIBFEAT_window_t *win);
+
+/** \brief  Accumulate samples, one pass, no per-sample storage
+ * \param win Window
+ * \param xyz Samples, x, y, z interleaved
+ * \param count Number of x, y, z samples
+ * \return Samples taken, less than count when the window fills
+ */
+size_t VIBFEAT_Feed(VIBFEAT_window_t *win, const int16_t *xyz, size_t count);
+
+/** \brief  Window holds its configured number of samples
+ * \param win Window
+ * \return Window full
+ */
+bool VIBFEAT_Ready(const VIBFEAT_window_t *win);
+
+/** \brief  Features of every axis of a full window, then start a new one
+ * \param win Window
+ * \param features VIBFEAT_AXES results
+ * \return ESP_ERR_INVALID_STATE when the window is not full
+ */
+esp_err_t VIBFEAT_Process(VIBFEAT_window_t *win, VIBFEAT_features_t *features);
+
+#endif /* VIBFEAT_H_ */
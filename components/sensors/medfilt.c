@@ -0,0 +1,332 @@
+/**
+ * \file medfilt.c
+ * \author Ugurcan OZTURK
+ * \brief	Running Median Filter Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "medfilt.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    MEDFILT_SIGN16            0x8000U     /* Flipped sign bit orders signed keys */
+#define    MEDFILT_SIGN32            0x80000000UL
+#define    MEDFILT_BLOCK_CHUNK       32          /* Keys converted per step of the block API */
+
+/* Compare-exchange, a <= b afterwards. Plain min/max, the compiler emits
+   MINU/MAXU on Xtensa and conditional moves elsewhere, no branches */
+#define    MEDFILT_MIN(a, b)         (((a) < (b)) ? (a) : (b))
+#define    MEDFILT_MAX(a, b)         (((a) < (b)) ? (b) : (a))
+#define    MEDFILT_CX(a, b)          do{ uint32_t lo_ = MEDFILT_MIN(a, b); (b) = MEDFILT_MAX(a, b); (a) = lo_; }while(0)
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Sorted ring step: replace the oldest key and keep the sorted copy
+ *          ascending, also used by every window while it fills
+ * \param filt Filter
+ * \param key Order-preserving key of the new sample
+ * \return Key of the median
+ */
+static uint32_t MEDFILT_SortedPush(MEDFILT_t *filt, uint32_t key);
+
+/** \brief  Filter keys in place, network kernels once a 3..9 window is full
+ * \param filt Filter
+ * \param keys Keys in, median keys out
+ * \param count Number of keys
+ * \return Nothing
+ */
+static void MEDFILT_Keys(MEDFILT_t *filt, uint32_t *keys, size_t count);
+
+/** \brief  Order-preserving keys of strided samples of the filter type
+ * \param type Sample type
+ * \param in Samples
+ * \param stride Distance between samples in elements
+ * \param keys Keys
+ * \param count Number of samples
+ * \return Nothing
+ */
+static void MEDFILT_Load(MEDFILT_type_e type, const void *in, size_t stride, uint32_t *keys, size_t count);
+
+/** \brief  Samples of the filter type from keys, see MEDFILT_Load
+ * \param type Sample type
+ * \param keys Keys
+ * \param out Samples
+ * \param stride Distance between samples in elements
+ * \param count Number of samples
+ * \return Nothing
+ */
+static void MEDFILT_Store(MEDFILT_type_e type, const uint32_t *keys, void *out, size_t stride, size_t count);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+/* Median selection networks, v is scratch. 3: 3, 5: 7, 7: 13, 9: 19 exchanges */
+static inline uint32_t MEDFILT_Median3(uint32_t *v){
+
+     return MEDFILT_MAX(MEDFILT_MIN(v[0], v[1]), MEDFILT_MIN(MEDFILT_MAX(v[0], v[1]), v[2]));
+}
+
+static inline uint32_t MEDFILT_Median5(uint32_t *v){
+
+     MEDFILT_CX(v[0], v[1]); MEDFILT_CX(v[3], v[4]); MEDFILT_CX(v[0], v[3]);
+     MEDFILT_CX(v[1], v[4]); MEDFILT_CX(v[1], v[2]); MEDFILT_CX(v[2], v[3]);
+     MEDFILT_CX(v[1], v[2]);
+     return v[2];
+}
+
+static inline uint32_t MEDFILT_Median7(uint32_t *v){
+
+     MEDFILT_CX(v[0], v[5]); MEDFILT_CX(v[0], v[3]); MEDFILT_CX(v[1], v[6]);
+     MEDFILT_CX(v[2], v[4]); MEDFILT_CX(v[0], v[1]); MEDFILT_CX(v[3], v[5]);
+     MEDFILT_CX(v[2], v[6]); MEDFILT_CX(v[2], v[3]); MEDFILT_CX(v[3], v[6]);
+     MEDFILT_CX(v[4], v[5]); MEDFILT_CX(v[1], v[4]); MEDFILT_CX(v[1], v[3]);
+     MEDFILT_CX(v[3], v[4]);
+     return v[3];
+}
+
+static inline uint32_t MEDFILT_Median9(uint32_t *v){
+
+     MEDFILT_CX(v[1], v[2]); MEDFILT_CX(v[4], v[5]); MEDFILT_CX(v[7], v[8]);
+     MEDFILT_CX(v[0], v[1]); MEDFILT_CX(v[3], v[4]); MEDFILT_CX(v[6], v[7]);
+     MEDFILT_CX(v[1], v[2]); MEDFILT_CX(v[4], v[5]); MEDFILT_CX(v[7], v[8]);
+     MEDFILT_CX(v[0], v[3]); MEDFILT_CX(v[5], v[8]); MEDFILT_CX(v[4], v[7]);
+     MEDFILT_CX(v[3], v[6]); MEDFILT_CX(v[1], v[4]); MEDFILT_CX(v[2], v[5]);
+     MEDFILT_CX(v[4], v[7]); MEDFILT_CX(v[4], v[2]); MEDFILT_CX(v[6], v[4]);
+     MEDFILT_CX(v[4], v[2]);
+     return v[4];
+}
+
+/* One loop per network window, the window and its kernel are compile-time constants */
+#define    MEDFILT_NETWORK_RUN(W)                                                        \
+static void MEDFILT_Run##W(MEDFILT_t *filt, uint32_t *keys, size_t count){                \
+                                                                                          \
+     uint32_t v[W];                                                                       \
+     uint16_t oldest = filt->oldest_u16;                                                  \
+                                                                                          \
+     for(size_t i = 0; i < count; i++){                                                   \
+          filt->ring[oldest] = keys[i];                                                   \
+          oldest = (oldest + 1 == W) ? 0 : (uint16_t)(oldest + 1);                        \
+          memcpy(v, filt->ring, sizeof(v));                                               \
+          keys[i] = MEDFILT_Median##W(v);                                                 \
+     }                                                                                    \
+     filt->oldest_u16 = oldest;                                                           \
+}
+
+MEDFILT_NETWORK_RUN(3)
+MEDFILT_NETWORK_RUN(5)
+MEDFILT_NETWORK_RUN(7)
+MEDFILT_NETWORK_RUN(9)
+
+static uint32_t MEDFILT_SortedPush(MEDFILT_t *filt, uint32_t key){
+
+     uint32_t *sorted = filt->sorted;
+     uint16_t n = filt->count_u16;
+     uint16_t pos, lo, hi;
+
+     if(n == filt->window_u16){
+          /* Any copy of the leaving key will do, equal keys are interchangeable */
+          lo = 0;
+          hi = n - 1;
+          while(lo < hi){
+               pos = (lo + hi) / 2;
+               if(sorted[pos] < filt->ring[filt->oldest_u16]){
+                    lo = pos + 1;
+               }else
+               {
+                    hi = pos;
+               }
+          }
+          /* Slide the new key from the slot of the old one, only the keys between the two move */
+          pos = lo;
+          while(pos + 1 < n && sorted[pos + 1] < key){
+               sorted[pos] = sorted[pos + 1];
+               pos++;
+          }
+          while(pos > 0 && sorted[pos - 1] > key){
+               sorted[pos] = sorted[pos - 1];
+               pos--;
+          }
+     }else
+     {
+          pos = n;
+          while(pos > 0 && sorted[pos - 1] > key){
+               sorted[pos] = sorted[pos - 1];
+               pos--;
+          }
+          filt->count_u16 = ++n;
+     }
+     sorted[pos] = key;
+
+     filt->ring[filt->oldest_u16] = key;
+     filt->oldest_u16 = (filt->oldest_u16 + 1 == filt->window_u16) ? 0 : (uint16_t)(filt->oldest_u16 + 1);
+
+     return sorted[(n - 1) / 2];
+}
+
+static void MEDFILT_Keys(MEDFILT_t *filt, uint32_t *keys, size_t count){
+
+     size_t i = 0;
+     bool network = filt->window_u16 >= 3 && filt->window_u16 <= MEDFILT_NETWORK_MAX;
+
+     while(i < count && (!network || filt->count_u16 < filt->window_u16)){
+          keys[i] = MEDFILT_SortedPush(filt, keys[i]);
+          i++;
+     }
+
+     switch(filt->window_u16){
+     case 3:
+          MEDFILT_Run3(filt, &keys[i], count - i);
+          break;
+     case 5:
+          MEDFILT_Run5(filt, &keys[i], count - i);
+          break;
+     case 7:
+          MEDFILT_Run7(filt, &keys[i], count - i);
+          break;
+     case 9:
+          MEDFILT_Run9(filt, &keys[i], count - i);
+          break;
+     default:
+          break;
+     }
+}
+
+static void MEDFILT_Load(MEDFILT_type_e type, const void *in, size_t stride, uint32_t *keys, size_t count){
+
+     switch(type){
+     case MEDFILT_TYPE_S16:
+          for(size_t i = 0; i < count; i++){
+               keys[i] = (uint16_t)((const int16_t *)in)[i * stride] ^ MEDFILT_SIGN16;
+          }
+          break;
+     case MEDFILT_TYPE_U16:
+          for(size_t i = 0; i < count; i++){
+               keys[i] = ((const uint16_t *)in)[i * stride];
+          }
+          break;
+     case MEDFILT_TYPE_S32:
+          for(size_t i = 0; i < count; i++){
+               keys[i] = (uint32_t)((const int32_t *)in)[i * stride] ^ MEDFILT_SIGN32;
+          }
+          break;
+     case MEDFILT_TYPE_U32:
+          for(size_t i = 0; i < count; i++){
+               keys[i] = ((const uint32_t *)in)[i * stride];
+          }
+          break;
+     default:
+          break;
+     }
+}
+
+static void MEDFILT_Store(MEDFILT_type_e type, const uint32_t *keys, void *out, size_t stride, size_t count){
+
+     switch(type){
+     case MEDFILT_TYPE_S16:
+          for(size_t i = 0; i < count; i++){
+               ((int16_t *)out)[i * stride] = (int16_t)(keys[i] ^ MEDFILT_SIGN16);
+          }
+          break;
+     case MEDFILT_TYPE_U16:
+          for(size_t i = 0; i < count; i++){
+               ((uint16_t *)out)[i * stride] = (uint16_t)keys[i];
+          }
+          break;
+     case MEDFILT_TYPE_S32:
+          for(size_t i = 0; i < count; i++){
+               ((int32_t *)out)[i * stride] = (int32_t)(keys[i] ^ MEDFILT_SIGN32);
+          }
+          break;
+     case MEDFILT_TYPE_U32:
+          for(size_t i = 0; i < count; i++){
+               ((uint32_t *)out)[i * stride] = keys[i];
+          }
+          break;
+     default:
+          break;
+     }
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+esp_err_t MEDFILT_Init(MEDFILT_t *filt, MEDFILT_type_e type, uint32_t *storage, uint16_t window){
+
+     if(storage == NULL || window == 0 || window > MEDFILT_WINDOW_MAX || (window & 1) == 0){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     filt->type       = type;
+     filt->window_u16 = window;
+     filt->ring       = storage;
+     filt->sorted     = storage + window;
+     MEDFILT_Reset(filt);
+
+     return ESP_OK;
+}
+
+void MEDFILT_Reset(MEDFILT_t *filt){
+
+     filt->count_u16  = 0;
+     filt->oldest_u16 = 0;
+}
+
+int16_t MEDFILT_PutS16(MEDFILT_t *filt, int16_t x){
+
+     uint32_t key = (uint16_t)x ^ MEDFILT_SIGN16;
+
+     MEDFILT_Keys(filt, &key, 1);
+     return (int16_t)(key ^ MEDFILT_SIGN16);
+}
+
+uint16_t MEDFILT_PutU16(MEDFILT_t *filt, uint16_t x){
+
+     uint32_t key = x;
+
+     MEDFILT_Keys(filt, &key, 1);
+     return (uint16_t)key;
+}
+
+int32_t MEDFILT_PutS32(MEDFILT_t *filt, int32_t x){
+
+     uint32_t key = (uint32_t)x ^ MEDFILT_SIGN32;
+
+     MEDFILT_Keys(filt, &key, 1);
+     return (int32_t)(key ^ MEDFILT_SIGN32);
+}
+
+uint32_t MEDFILT_PutU32(MEDFILT_t *filt, uint32_t x){
+
+     MEDFILT_Keys(filt, &x, 1);
+     return x;
+}
+
+void MEDFILT_Block(MEDFILT_t *filt, const void *in, void *out, size_t count, size_t stride){
+
+     uint32_t keys[MEDFILT_BLOCK_CHUNK];
+     size_t elemSize = (filt->type == MEDFILT_TYPE_S16 || filt->type == MEDFILT_TYPE_U16) ? 2 : 4;
+     size_t n;
+
+     /* Type resolved once per chunk, the median loop runs on keys only */
+     for(size_t done = 0; done < count; done += n){
+          n = (count - done < MEDFILT_BLOCK_CHUNK) ? count - done : MEDFILT_BLOCK_CHUNK;
+          MEDFILT_Load(filt->type, (const uint8_t *)in + done * stride * elemSize, stride, keys, n);
+          MEDFILT_Keys(filt, keys, n);
+          MEDFILT_Store(filt->type, keys, (uint8_t *)out + done * stride * elemSize, stride, n);
+     }
+}
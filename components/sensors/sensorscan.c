@@ -0,0 +1,289 @@
+/**
+ * \file sensorscan.c
+ * \author Ugurcan OZTURK
+ * \brief	Boot-Time Sensor Enumeration Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "nvs.h"
+#include "sensorscan.h"
+#include "bmx280.h"
+#include "adxl345.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    ADXL345_ADDR_PRIMARY      0x53  /* ALT ADDRESS to GND */
+#define    ADXL345_ADDR_SECONDARY    0x1D  /* ALT ADDRESS to VDDIO */
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct SENSORSCAN_candidate_t
+*   @brief Address and identification register of one candidate
+*/
+typedef struct{
+
+    uint8_t            addr_u8;
+    uint8_t            idReg_u8;
+}SENSORSCAN_candidate_t;
+
+/** @struct SENSORSCAN_job_t
+*   @brief Enumeration of one port, run by its own task
+*/
+typedef struct{
+
+    i2c_port_t                 port;
+    TaskHandle_t               owner;      /* Notified when the job is done */
+    size_t                     count;
+    SENSORSCAN_entry_t         entries[SENSORSCAN_PORT_PARTS];
+}SENSORSCAN_job_t;
+
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static const SENSORSCAN_candidate_t candidates[SENSORSCAN_PORT_PARTS] = {
+     { BMX280_ADDR_PRIMARY,    REGISTER_ID_ADDR    },
+     { BMX280_ADDR_SECONDARY,  REGISTER_ID_ADDR    },
+     { ADXL345_ADDR_PRIMARY,   REGISTER_DEVID_ADDR },
+     { ADXL345_ADDR_SECONDARY, REGISTER_DEVID_ADDR },
+};
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Read the identification register and classify the part
+ * \param port I2C controller
+ * \param addr Slave address
+ * \param idReg REGISTER_ID_ADDR or REGISTER_DEVID_ADDR
+ * \return SENSORSCAN_PART_NONE when nothing answers or the ID is unknown
+ */
+static SENSORSCAN_part_e SENSORSCAN_Identify(i2c_port_t port, uint8_t addr, uint8_t idReg);
+
+/** \brief  Identify every candidate address of the job port, the cached
+ *          parts included, so a part added next to them is found
+ * \param job Port job
+ * \return Nothing
+ */
+static void SENSORSCAN_RunJob(SENSORSCAN_job_t *job);
+
+/** \brief  Port task, runs one job and notifies the owner
+ * \param param Port job
+ * \return Nothing
+ */
+static void SENSORSCAN_Task(void *param);
+
+/** \brief  Read the cached result
+ * \param result NVS copy
+ * \return ESP_ERR_INVALID_VERSION for a blob of another layout
+ */
+static esp_err_t SENSORSCAN_Load(SENSORSCAN_result_t *result);
+
+/** \brief  Write the result to NVS
+ * \param result Enumeration result
+ * \return NVS status
+ */
+static esp_err_t SENSORSCAN_Store(const SENSORSCAN_result_t *result);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static SENSORSCAN_part_e SENSORSCAN_Identify(i2c_port_t port, uint8_t addr, uint8_t idReg){
+
+     uint8_t id;
+
+     if(I2CBUS_ProbeAddr(port, addr, idReg, &id, SENSORSCAN_TIMEOUT_MS) != ESP_OK){
+          return SENSORSCAN_PART_NONE;
+     }
+
+     if(idReg == REGISTER_ID_ADDR && id == BMX280_CHIP_ID_BME280){
+          return SENSORSCAN_PART_BME280;
+     }
+     if(idReg == REGISTER_ID_ADDR && id == BMX280_CHIP_ID_BMP280){
+          return SENSORSCAN_PART_BMP280;
+     }
+     if(idReg == REGISTER_DEVID_ADDR && id == ADXL345_DEVID){
+          return SENSORSCAN_PART_ADXL345;
+     }
+
+     return SENSORSCAN_PART_NONE;
+}
+
+static void SENSORSCAN_RunJob(SENSORSCAN_job_t *job){
+
+     /* Confirming a cached part is the same chip-ID read as probing its
+        address, an absent candidate costs one NACK */
+     job->count = SENSORSCAN_ScanPort(job->port, job->entries);
+}
+
+static void SENSORSCAN_Task(void *param){
+
+     SENSORSCAN_job_t *job = (SENSORSCAN_job_t *)param;
+
+     SENSORSCAN_RunJob(job);
+     xTaskNotifyGive(job->owner);
+
+     vTaskDelete(NULL);
+}
+
+static esp_err_t SENSORSCAN_Load(SENSORSCAN_result_t *result){
+
+     nvs_handle_t handle;
+     size_t len = sizeof(*result);
+     esp_err_t err;
+
+     err = nvs_open(SENSORSCAN_NVS_NAMESPACE, NVS_READONLY, &handle);
+
+     if(err == ESP_OK){
+          err = nvs_get_blob(handle, SENSORSCAN_NVS_KEY, result, &len);
+          nvs_close(handle);
+     }
+
+     if(err == ESP_OK && (len != sizeof(*result) || result->version_u8 != SENSORSCAN_VERSION ||
+                          result->count_u8 > SENSORSCAN_PARTS_MAX)){
+          err = ESP_ERR_INVALID_VERSION;
+     }
+
+     return err;
+}
+
+static esp_err_t SENSORSCAN_Store(const SENSORSCAN_result_t *result){
+
+     nvs_handle_t handle;
+     esp_err_t err;
+
+     err = nvs_open(SENSORSCAN_NVS_NAMESPACE, NVS_READWRITE, &handle);
+
+     if(err == ESP_OK){
+          err = nvs_set_blob(handle, SENSORSCAN_NVS_KEY, result, sizeof(*result));
+          if(err == ESP_OK){
+               err = nvs_commit(handle);
+          }
+          nvs_close(handle);
+     }
+
+     return err;
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+esp_err_t SENSORSCAN_Discover(const i2c_port_t *ports, size_t count, SENSORSCAN_result_t *result){
+
+     SENSORSCAN_job_t jobs[I2C_NUM_MAX];
+     SENSORSCAN_result_t cached;
+     bool cacheValid;
+     size_t started = 0;
+
+     if(ports == NULL || result == NULL || count > I2C_NUM_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     cacheValid = (SENSORSCAN_Load(&cached) == ESP_OK);
+
+     /* One task per port, the chip-ID reads of different controllers overlap */
+     for(size_t p = 0; p < count; p++){
+          jobs[p].port   = ports[p];
+          jobs[p].owner  = xTaskGetCurrentTaskHandle();
+
+          if(xTaskCreate(SENSORSCAN_Task, "i2c_scan", SENSORSCAN_TASK_STACK, &jobs[p], SENSORSCAN_TASK_PRIORITY, NULL) == pdPASS){
+               started++;
+          }else
+          {
+               SENSORSCAN_RunJob(&jobs[p]);
+          }
+     }
+
+     for(size_t done = 0; done < started; done++){
+          ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+     }
+
+     memset(result, 0, sizeof(*result));
+     result->version_u8 = SENSORSCAN_VERSION;
+
+     for(size_t p = 0; p < count; p++){
+          result->portMask_u8 |= (uint8_t)(1U << ports[p]);
+          for(size_t i = 0; i < jobs[p].count; i++){
+               result->entries[result->count_u8++] = jobs[p].entries[i];
+          }
+     }
+
+     /* Only a changed result is written, a rescan on every boot would wear the flash */
+     result->fromCache = cacheValid && cached.portMask_u8 == result->portMask_u8 && cached.count_u8 == result->count_u8 &&
+                         memcmp(cached.entries, result->entries, result->count_u8 * sizeof(result->entries[0])) == 0;
+
+     if(!result->fromCache){
+          SENSORSCAN_Store(result);
+     }
+
+     return ESP_OK;
+}
+
+size_t SENSORSCAN_ScanPort(i2c_port_t port, SENSORSCAN_entry_t *entries){
+
+     SENSORSCAN_part_e part;
+     size_t count = 0;
+
+     for(size_t i = 0; i < SENSORSCAN_PORT_PARTS; i++){
+          part = SENSORSCAN_Identify(port, candidates[i].addr_u8, candidates[i].idReg_u8);
+          if(part != SENSORSCAN_PART_NONE){
+               entries[count].port_u8  = (uint8_t)port;
+               entries[count].addr_u8  = candidates[i].addr_u8;
+               entries[count].part_u8  = (uint8_t)part;
+               entries[count].taken_u8 = 0;
+               count++;
+          }
+     }
+
+     return count;
+}
+
+esp_err_t SENSORSCAN_Take(SENSORSCAN_result_t *result, SENSORSCAN_part_e part, I2CBUS_device_t *dev){
+
+     for(size_t i = 0; i < result->count_u8; i++){
+          if(result->entries[i].part_u8 == part && result->entries[i].taken_u8 == 0){
+               result->entries[i].taken_u8 = 1;
+               dev->port = (i2c_port_t)result->entries[i].port_u8;
+               dev->addr = result->entries[i].addr_u8;
+               return ESP_OK;
+          }
+     }
+
+     return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t SENSORSCAN_Forget(void){
+
+     nvs_handle_t handle;
+     esp_err_t err;
+
+     err = nvs_open(SENSORSCAN_NVS_NAMESPACE, NVS_READWRITE, &handle);
+
+     if(err == ESP_OK){
+          err = nvs_erase_key(handle, SENSORSCAN_NVS_KEY);
+          if(err == ESP_OK){
+               err = nvs_commit(handle);
+          }
+          nvs_close(handle);
+     }
+
+     return err;
+}
@@ -0,0 +1,1682 @@
+/**
+ * \file i2csim.c
+ * \author Ugurcan OZTURK
+ * \brief	Linux Host I2C Bus Simulator Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "i2csim.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    BMX280_CHIP_ID            0x60
+#define    BMP280_CHIP_ID            0x58
+#define    ADXL345_DEVID             0xE5
+#define    BMX280_RESET_WORD         0xB6
+
+#define    BMX280_REG_CALIB          0x88
+#define    BMX280_REG_CALIB_HUM      0xE1
+#define    BMX280_REG_ID             0xD0
+#define    BMX280_REG_RESET          0xE0
+#define    BMX280_REG_CTRL_HUM       0xF2
+#define    BMX280_REG_STATUS         0xF3
+#define    BMX280_REG_CTRL_MEAS      0xF4
+#define    BMX280_REG_CONFIG         0xF5
+#define    BMX280_REG_DATA           0xF7
+
+#define    ADXL_REG_DEVID            0x00
+#define    ADXL_REG_THRESH_TAP       0x1D
+#define    ADXL_REG_DUR              0x21
+#define    ADXL_REG_THRESH_ACT       0x24
+#define    ADXL_REG_THRESH_INACT     0x25
+#define    ADXL_REG_TIME_INACT       0x26
+#define    ADXL_REG_ACT_INACT_CTL    0x27
+#define    ADXL_REG_THRESH_FF        0x28
+#define    ADXL_REG_TIME_FF          0x29
+#define    ADXL_REG_TAP_AXES         0x2A
+#define    ADXL_REG_ACT_TAP_STATUS   0x2B
+#define    ADXL_REG_BW_RATE          0x2C
+#define    ADXL_REG_POWER_CTL        0x2D
+#define    ADXL_REG_INT_ENABLE       0x2E
+#define    ADXL_REG_INT_MAP          0x2F
+#define    ADXL_REG_INT_SOURCE       0x30
+#define    ADXL_REG_DATA_FORMAT      0x31
+#define    ADXL_REG_DATAX0           0x32
+#define    ADXL_REG_DATAZ1           0x37
+#define    ADXL_REG_FIFO_CTL         0x38
+#define    ADXL_REG_FIFO_STATUS      0x39
+
+#define    ADXL_INT_DATA_READY       0x80
+#define    ADXL_INT_SINGLE_TAP       0x40
+#define    ADXL_INT_ACTIVITY         0x10
+#define    ADXL_INT_INACTIVITY       0x08
+#define    ADXL_INT_FREE_FALL        0x04
+#define    ADXL_INT_WATERMARK        0x02
+#define    ADXL_INT_OVERRUN          0x01
+#define    ADXL_POWER_LINK           0x20
+#define    ADXL_POWER_AUTO_SLEEP     0x10
+#define    ADXL_POWER_MEASURE        0x08
+#define    ADXL_STATUS_ASLEEP        0x08
+
+#define    DEFAULT_RAW_PRESS         415148
+#define    DEFAULT_RAW_TEMP          519888
+#define    DEFAULT_RAW_HUM           30000
+#define    DEFAULT_CLK_SPEED         100000
+#define    SIM_GPIO_COUNT            40
+#define    ADXL_SPI_READ             0x80
+#define    ADXL_SPI_MB               0x40
+#define    ADXL_SPI_MODE             3
+#define    ADXL_SPI_CLK_MAX          5000000
+#define    SPI_TRANS_OVERHEAD_NS     2000  /* CS setup and driver turnaround per transaction */
+
+
+/******************************************************************************
+ *** ENUMS
+ ******************************************************************************/
+typedef enum{
+    CMD_START,
+    CMD_WRITE,
+    CMD_READ,
+    CMD_STOP
+}I2CSIM_cmdType_e;
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+typedef struct{
+
+    I2CSIM_cmdType_e type;
+    const uint8_t   *tx;          /* NULL when the single byte is used */
+    uint8_t          byte;
+    uint8_t         *rx;
+    size_t           len;
+}I2CSIM_cmd_t;
+
+typedef struct{
+
+    I2CSIM_cmd_t *cmds;
+    size_t        count;
+    size_t        cap;
+}I2CSIM_link_t;
+
+typedef struct{
+
+    bool          used;
+    i2c_port_t    port;
+    uint8_t       addr;
+    I2CSIM_part_e part;
+    uint8_t       regs[256];
+    uint8_t       regPtr;
+    uint32_t      nackCount;
+    uint32_t      stretchUs;
+    uint32_t      maxClkSpeed;    /* Address NACKed above this SCL frequency, 0 for none */
+    bool          dataRead;       /* Data registers touched in this transaction */
+
+    /* BMx280 */
+    int32_t       rawPress;
+    int32_t       rawTemp;
+    int32_t       rawHum;
+    uint8_t       osrsHum;        /* ctrl_hum latched by the last ctrl_meas write */
+    bool          converting;
+    int64_t       convDoneUs;
+
+    /* ADXL345 */
+    int16_t       fifo[I2CSIM_ADXL_FIFO_DEPTH][3];
+    uint8_t       fifoHead;
+    uint8_t       fifoCount;
+    int16_t       lastOut[3];
+    bool          newData;
+    bool          overrun;
+    int64_t       lastSampleUs;
+    uint32_t      sampleIndex;
+    I2CSIM_adxlSource_t source;
+    void         *sourceArg;
+    bool          motionAwake;    /* Link mode: activity found, inactivity armed */
+    bool          motionRef;      /* AC references taken */
+    int32_t       actRef[3];
+    int32_t       inactRef[3];
+    int64_t       inactUs;        /* Time below THRESH_INACT */
+    int64_t       ffUs;           /* Time below THRESH_FF */
+    int64_t       tapUs;          /* Time above THRESH_TAP */
+    bool          inactFired;
+    bool          ffFired;
+    int           intGpio[2];     /* INT1, INT2 pins, -1 when not wired */
+    bool          intLevel[2];
+}I2CSIM_device_t;
+
+struct spi_device_t{
+
+    bool                           used;
+    spi_host_device_t              host;
+    spi_device_interface_config_t  conf;
+    spi_transaction_t             *queue[I2CSIM_SPI_QUEUE_MAX];
+    uint8_t                        head;
+    uint8_t                        count;
+};
+
+typedef struct{
+
+    bool          initialized;
+    uint64_t      busTimeNs;
+}I2CSIM_spiBus_t;
+
+typedef struct{
+
+    gpio_isr_t    handler;
+    void         *arg;
+    bool          enabled;
+}I2CSIM_isr_t;
+
+typedef struct{
+
+    bool          installed;
+    uint32_t      clkSpeed;
+    uint32_t      latencyUs;
+    uint64_t      busTimeNs;
+    int           sdaIo;
+    int           sclIo;
+    uint32_t      sdaHeldClocks;  /* SCL pulses until a stuck slave releases SDA, 0 when free */
+    bool          sclLow;
+}I2CSIM_bus_t;
+
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static pthread_mutex_t simLock = PTHREAD_MUTEX_INITIALIZER;
+static I2CSIM_device_t simDevices[I2CSIM_MAX_DEVICES];
+static I2CSIM_bus_t simBus[I2C_NUM_MAX];
+static bool simRealTime;
+static uint64_t simVirtualNs;     /* Bus time not slept in real time */
+static I2CSIM_isr_t simIsr[SIM_GPIO_COUNT];
+static bool simIsrService;
+static struct spi_device_t simSpiDevices[I2CSIM_MAX_DEVICES];
+static I2CSIM_spiBus_t simSpiBus[SPI_HOST_MAX];
+
+/* Bosch datasheet example trimming values, typical humidity trimming */
+static const uint16_t nvmTP[12] = {
+    27504, 26435, (uint16_t)-1000, 36477, (uint16_t)-10685, 3024,
+    2855, 140, (uint16_t)-7, 15500, (uint16_t)-14600, 6000
+};
+static const uint8_t  nvmH1 = 75;
+static const int16_t  nvmH2 = 370;
+static const uint8_t  nvmH3 = 0;
+static const int16_t  nvmH4 = 308;
+static const int16_t  nvmH5 = 50;
+static const int8_t   nvmH6 = 30;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Monotonic host time
+ * \param[] Nothing
+ * \return Time (us)
+ */
+static int64_t I2CSIM_NowUs(void);
+
+/** \brief  Find the model answering an address on a bus
+ * \param port Bus number
+ * \param addr Slave address
+ * \return Device model or NULL
+ */
+static I2CSIM_device_t *I2CSIM_Find(i2c_port_t port, uint8_t addr);
+
+/** \brief  Load power-on register values of a model
+ * \param dev Device model
+ * \return Nothing
+ */
+static void I2CSIM_PowerOn(I2CSIM_device_t *dev);
+
+/** \brief  Model hook at the address phase of a transaction
+ * \param dev Device model
+ * \param nowUs Host time
+ * \return Nothing
+ */
+static void I2CSIM_Begin(I2CSIM_device_t *dev, int64_t nowUs);
+
+/** \brief  Model hook at the stop or repeated start ending a transaction
+ * \param dev Device model
+ * \return Nothing
+ */
+static void I2CSIM_End(I2CSIM_device_t *dev);
+
+/** \brief  Model register read with side effects
+ * \param dev Device model
+ * \param reg Register address
+ * \return Register value
+ */
+static uint8_t I2CSIM_RegRead(I2CSIM_device_t *dev, uint8_t reg);
+
+/** \brief  Model register write with side effects
+ * \param dev Device model
+ * \param reg Register address
+ * \param data Register value
+ * \return Nothing
+ */
+static void I2CSIM_RegWrite(I2CSIM_device_t *dev, uint8_t reg, uint8_t data);
+
+/** \brief  Run one SPI transaction against the model selected by the CS pin
+ * \param spi SPI device
+ * \param trans Transaction
+ * \return  ESP_OK or ESP_ERR_INVALID_ARG for a malformed transaction
+ */
+static esp_err_t I2CSIM_SpiExecute(struct spi_device_t *spi, spi_transaction_t *trans);
+
+/** \brief  Append a command to a link
+ * \param link Command link
+ * \return New command or NULL
+ */
+static I2CSIM_cmd_t *I2CSIM_Append(I2CSIM_link_t *link);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static int64_t I2CSIM_NowUs(void){
+
+     struct timespec ts;
+
+     clock_gettime(CLOCK_MONOTONIC, &ts);
+
+     return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 + (int64_t)(simVirtualNs / 1000);
+}
+
+static I2CSIM_device_t *I2CSIM_Find(i2c_port_t port, uint8_t addr){
+
+     for(int i = 0; i < I2CSIM_MAX_DEVICES; i++){
+          if(simDevices[i].used && simDevices[i].port == port && simDevices[i].addr == addr){
+               return &simDevices[i];
+          }
+     }
+     return NULL;
+}
+
+/* BMx280 oversampling code to sample count */
+static uint32_t I2CSIM_Oversampling(uint8_t osrs){
+
+     static const uint8_t count[8] = {0, 1, 2, 4, 8, 16, 16, 16};
+
+     return count[osrs & 0x07];
+}
+
+/* Datasheet maximum measurement time of the latched BMx280 settings */
+static uint32_t I2CSIM_Bmx280MeasUs(I2CSIM_device_t *dev){
+
+     uint8_t  ctrlMeas = dev->regs[BMX280_REG_CTRL_MEAS];
+     uint32_t osT = I2CSIM_Oversampling(ctrlMeas >> 5);
+     uint32_t osP = I2CSIM_Oversampling(ctrlMeas >> 2);
+     uint32_t osH = (dev->part == I2CSIM_BME280) ? I2CSIM_Oversampling(dev->osrsHum) : 0;
+     uint32_t us = 1250 + 2300 * osT;
+
+     if(osP != 0){
+          us += 2300 * osP + 575;
+     }
+     if(osH != 0){
+          us += 2300 * osH + 575;
+     }
+     return us;
+}
+
+/* Conversion result into the data registers, skipped channels read 0x80000 */
+static void I2CSIM_Bmx280Convert(I2CSIM_device_t *dev){
+
+     uint8_t  ctrlMeas = dev->regs[BMX280_REG_CTRL_MEAS];
+     int32_t  press = ((ctrlMeas >> 2) & 0x07) ? dev->rawPress : 0x80000;
+     int32_t  temp  = ((ctrlMeas >> 5) & 0x07) ? dev->rawTemp  : 0x80000;
+     uint8_t *data  = &dev->regs[BMX280_REG_DATA];
+
+     data[0] = (uint8_t)(press >> 12);
+     data[1] = (uint8_t)(press >> 4);
+     data[2] = (uint8_t)((press & 0x0F) << 4);
+     data[3] = (uint8_t)(temp >> 12);
+     data[4] = (uint8_t)(temp >> 4);
+     data[5] = (uint8_t)((temp & 0x0F) << 4);
+
+     if(dev->part == I2CSIM_BME280){
+          int32_t hum = (dev->osrsHum & 0x07) ? dev->rawHum : 0x8000;
+
+          data[6] = (uint8_t)(hum >> 8);
+          data[7] = (uint8_t)hum;
+     }
+}
+
+static void I2CSIM_PowerOn(I2CSIM_device_t *dev){
+
+     memset(dev->regs, 0, sizeof(dev->regs));
+
+     if(dev->part == I2CSIM_ADXL345){
+          dev->regs[ADXL_REG_DEVID]      = ADXL345_DEVID;
+          dev->regs[ADXL_REG_BW_RATE]    = 0x0A;
+          dev->regs[ADXL_REG_INT_SOURCE] = 0x02;
+          dev->fifoHead  = 0;
+          dev->fifoCount = 0;
+          dev->newData   = false;
+          dev->overrun   = false;
+          memset(dev->lastOut, 0, sizeof(dev->lastOut));
+          return;
+     }
+
+     dev->regs[BMX280_REG_ID] = (dev->part == I2CSIM_BME280) ? BMX280_CHIP_ID : BMP280_CHIP_ID;
+
+     for(int i = 0; i < 12; i++){
+          dev->regs[BMX280_REG_CALIB + 2 * i]     = (uint8_t)nvmTP[i];
+          dev->regs[BMX280_REG_CALIB + 2 * i + 1] = (uint8_t)(nvmTP[i] >> 8);
+     }
+
+     if(dev->part == I2CSIM_BME280){
+          dev->regs[0xA1] = nvmH1;
+          dev->regs[BMX280_REG_CALIB_HUM]     = (uint8_t)nvmH2;
+          dev->regs[BMX280_REG_CALIB_HUM + 1] = (uint8_t)((uint16_t)nvmH2 >> 8);
+          dev->regs[BMX280_REG_CALIB_HUM + 2] = nvmH3;
+          dev->regs[BMX280_REG_CALIB_HUM + 3] = (uint8_t)(nvmH4 >> 4);
+          dev->regs[BMX280_REG_CALIB_HUM + 4] = (uint8_t)((nvmH4 & 0x0F) | ((nvmH5 & 0x0F) << 4));
+          dev->regs[BMX280_REG_CALIB_HUM + 5] = (uint8_t)(nvmH5 >> 4);
+          dev->regs[BMX280_REG_CALIB_HUM + 6] = (uint8_t)nvmH6;
+     }
+
+     dev->osrsHum    = 0;
+     dev->converting = false;
+     I2CSIM_Bmx280Convert(dev);
+}
+
+/* Acceleration in mg to DATA_FORMAT scaled LSB */
+static int16_t I2CSIM_AdxlScale(I2CSIM_device_t *dev, int32_t mg){
+
+     uint8_t format = dev->regs[ADXL_REG_DATA_FORMAT];
+     uint8_t range  = format & 0x03;
+     int32_t lsb    = (mg * 256) / 1000;
+     int32_t limit;
+
+     if(format & 0x08){
+          limit = 512 << range;
+     }else
+     {
+          lsb  >>= range;
+          limit = 512;
+     }
+
+     if(lsb >= limit){
+          lsb = limit - 1;
+     }else if(lsb < -limit){
+          lsb = -limit;
+     }
+     return (int16_t)lsb;
+}
+
+/* Output data period, the wakeup rate while auto sleep has the part asleep */
+static int64_t I2CSIM_AdxlPeriodUs(I2CSIM_device_t *dev){
+
+     uint8_t rate = dev->regs[ADXL_REG_BW_RATE] & 0x0F;
+
+     if(dev->regs[ADXL_REG_ACT_TAP_STATUS] & ADXL_STATUS_ASLEEP){
+          return 125000LL << (dev->regs[ADXL_REG_POWER_CTL] & 0x03);
+     }
+     return (int64_t)((1000000ULL << (15 - rate)) / 3200);
+}
+
+static void I2CSIM_AdxlEvent(I2CSIM_device_t *dev, uint8_t event){
+
+     if(dev->regs[ADXL_REG_INT_ENABLE] & event){
+          dev->regs[ADXL_REG_INT_SOURCE] |= event;
+     }
+}
+
+/* Activity, inactivity, free-fall and single tap on each output sample, one
+   mg per axis as the source gives it, thresholds at 62.5 mg/LSB */
+static void I2CSIM_AdxlMotion(I2CSIM_device_t *dev, const int32_t mg[3], int64_t periodUs){
+
+     uint8_t ctl     = dev->regs[ADXL_REG_ACT_INACT_CTL];
+     uint8_t power   = dev->regs[ADXL_REG_POWER_CTL];
+     bool    link    = (power & ADXL_POWER_LINK) != 0;
+     int32_t actMg   = dev->regs[ADXL_REG_THRESH_ACT] * 625 / 10;
+     int32_t inactMg = dev->regs[ADXL_REG_THRESH_INACT] * 625 / 10;
+     int32_t ffMg    = dev->regs[ADXL_REG_THRESH_FF] * 625 / 10;
+     int32_t tapMg   = dev->regs[ADXL_REG_THRESH_TAP] * 625 / 10;
+     uint8_t actAxes = 0;
+     bool    below   = true;
+     bool    ffBelow = true;
+     bool    tapAbove = false;
+
+     if(!dev->motionRef){
+          memcpy(dev->actRef, mg, sizeof(dev->actRef));
+          memcpy(dev->inactRef, mg, sizeof(dev->inactRef));
+          dev->motionRef = true;
+     }
+
+     for(int i = 0; i < 3; i++){
+          int32_t act   = (ctl & 0x80) ? mg[i] - dev->actRef[i] : mg[i];
+          int32_t inact = (ctl & 0x08) ? mg[i] - dev->inactRef[i] : mg[i];
+
+          if((ctl & (0x40 >> i)) && abs(act) > actMg){
+               actAxes |= 0x40 >> i;
+          }
+          if((ctl & (0x04 >> i)) && abs(inact) > inactMg){
+               below = false;
+          }
+          if(abs(mg[i]) >= ffMg){
+               ffBelow = false;
+          }
+          if((dev->regs[ADXL_REG_TAP_AXES] & (0x04 >> i)) && abs(mg[i]) > tapMg){
+               tapAbove = true;
+          }
+     }
+
+     if(actAxes != 0 && (!link || !dev->motionAwake)){
+          I2CSIM_AdxlEvent(dev, ADXL_INT_ACTIVITY);
+          dev->regs[ADXL_REG_ACT_TAP_STATUS] = (dev->regs[ADXL_REG_ACT_TAP_STATUS] & 0x07) | actAxes;
+          dev->motionAwake = true;
+          dev->inactUs     = 0;
+          dev->inactFired  = false;
+          memcpy(dev->inactRef, mg, sizeof(dev->inactRef));
+     }
+
+     if((ctl & 0x07) != 0 && (!link || dev->motionAwake)){
+          if(!below){
+               dev->inactUs    = 0;
+               dev->inactFired = false;
+               memcpy(dev->inactRef, mg, sizeof(dev->inactRef));
+          }else
+          {
+               dev->inactUs += periodUs;
+          }
+          if(below && !dev->inactFired && dev->inactUs >= dev->regs[ADXL_REG_TIME_INACT] * 1000000LL){
+               I2CSIM_AdxlEvent(dev, ADXL_INT_INACTIVITY);
+               dev->inactFired = true;
+               memcpy(dev->actRef, mg, sizeof(dev->actRef));
+               if(link){
+                    dev->motionAwake = false;
+                    if(power & ADXL_POWER_AUTO_SLEEP){
+                         dev->regs[ADXL_REG_ACT_TAP_STATUS] |= ADXL_STATUS_ASLEEP;
+                    }
+               }
+          }
+     }
+
+     if(actAxes != 0){
+          dev->regs[ADXL_REG_ACT_TAP_STATUS] &= ~ADXL_STATUS_ASLEEP;
+     }
+
+     if(ffMg != 0 && ffBelow){
+          dev->ffUs += periodUs;
+          if(!dev->ffFired && dev->ffUs >= dev->regs[ADXL_REG_TIME_FF] * 5000LL){
+               I2CSIM_AdxlEvent(dev, ADXL_INT_FREE_FALL);
+               dev->ffFired = true;
+          }
+     }else
+     {
+          dev->ffUs    = 0;
+          dev->ffFired = false;
+     }
+
+     /* Single tap, above the threshold for no longer than DUR */
+     if(tapMg != 0 && tapAbove){
+          dev->tapUs += periodUs;
+     }else
+     {
+          if(dev->tapUs != 0 && dev->tapUs <= dev->regs[ADXL_REG_DUR] * 625LL){
+               I2CSIM_AdxlEvent(dev, ADXL_INT_SINGLE_TAP);
+          }
+          dev->tapUs = 0;
+     }
+}
+
+static void I2CSIM_AdxlPush(I2CSIM_device_t *dev){
+
+     int32_t mg[3] = {0, 0, 1000};
+     uint8_t fifoMode = dev->regs[ADXL_REG_FIFO_CTL] >> 6;
+     uint8_t slot;
+
+     if(dev->source != NULL){
+          dev->source(dev->sourceArg, dev->sampleIndex, mg);
+     }
+     dev->sampleIndex++;
+     I2CSIM_AdxlMotion(dev, mg, I2CSIM_AdxlPeriodUs(dev));
+
+     if(fifoMode == 0){
+          if(dev->newData){
+               dev->overrun = true;
+          }
+          for(int i = 0; i < 3; i++){
+               dev->lastOut[i] = I2CSIM_AdxlScale(dev, mg[i]);
+          }
+          dev->newData = true;
+          return;
+     }
+
+     if(dev->fifoCount == I2CSIM_ADXL_FIFO_DEPTH){
+          dev->overrun = true;
+          if(fifoMode == 1){
+               return;
+          }
+          dev->fifoHead = (dev->fifoHead + 1) % I2CSIM_ADXL_FIFO_DEPTH;
+          dev->fifoCount--;
+     }
+
+     slot = (dev->fifoHead + dev->fifoCount) % I2CSIM_ADXL_FIFO_DEPTH;
+     for(int i = 0; i < 3; i++){
+          dev->fifo[slot][i] = I2CSIM_AdxlScale(dev, mg[i]);
+     }
+     dev->fifoCount++;
+}
+
+/* Output registers show the oldest FIFO entry, or the latest sample in bypass */
+static void I2CSIM_AdxlLoadOutput(I2CSIM_device_t *dev){
+
+     const int16_t *xyz = dev->lastOut;
+
+     if((dev->regs[ADXL_REG_FIFO_CTL] >> 6) != 0 && dev->fifoCount > 0){
+          xyz = dev->fifo[dev->fifoHead];
+     }
+
+     for(int i = 0; i < 3; i++){
+          dev->regs[ADXL_REG_DATAX0 + 2 * i]     = (uint8_t)xyz[i];
+          dev->regs[ADXL_REG_DATAX0 + 2 * i + 1] = (uint8_t)((uint16_t)xyz[i] >> 8);
+     }
+}
+
+static void I2CSIM_AdxlUpdate(I2CSIM_device_t *dev, int64_t nowUs){
+
+     int64_t  periodUs = I2CSIM_AdxlPeriodUs(dev);
+     uint8_t  samples = dev->regs[ADXL_REG_FIFO_CTL] & 0x1F;
+     uint8_t  intSource;
+
+     if((dev->regs[ADXL_REG_POWER_CTL] & ADXL_POWER_MEASURE) == 0){
+          dev->lastSampleUs = nowUs;
+     }else
+     {
+          if(nowUs - dev->lastSampleUs > periodUs * (I2CSIM_ADXL_FIFO_DEPTH + 1)){
+               dev->lastSampleUs = nowUs - periodUs * (I2CSIM_ADXL_FIFO_DEPTH + 1);
+          }
+          while(dev->lastSampleUs + periodUs <= nowUs){
+               I2CSIM_AdxlPush(dev);
+               dev->lastSampleUs += periodUs;
+               periodUs = I2CSIM_AdxlPeriodUs(dev);
+          }
+     }
+
+     intSource = dev->regs[ADXL_REG_INT_SOURCE] & ~(ADXL_INT_DATA_READY | ADXL_INT_WATERMARK | ADXL_INT_OVERRUN);
+
+     if((dev->regs[ADXL_REG_FIFO_CTL] >> 6) == 0){
+          intSource |= dev->newData ? ADXL_INT_DATA_READY : 0;
+     }else
+     {
+          intSource |= (dev->fifoCount > 0) ? ADXL_INT_DATA_READY : 0;
+          intSource |= (dev->fifoCount >= samples) ? ADXL_INT_WATERMARK : 0;
+     }
+     intSource |= dev->overrun ? ADXL_INT_OVERRUN : 0;
+
+     dev->regs[ADXL_REG_INT_SOURCE]  = intSource;
+     dev->regs[ADXL_REG_FIFO_STATUS] = ((dev->regs[ADXL_REG_FIFO_CTL] >> 6) == 0) ? 0 : dev->fifoCount;
+
+     I2CSIM_AdxlLoadOutput(dev);
+}
+
+static void I2CSIM_Begin(I2CSIM_device_t *dev, int64_t nowUs){
+
+     dev->dataRead = false;
+
+     if(dev->part == I2CSIM_ADXL345){
+          I2CSIM_AdxlUpdate(dev, nowUs);
+          return;
+     }
+
+     switch (dev->regs[BMX280_REG_CTRL_MEAS] & 0x03)
+     {
+     case 0x00:
+          break;
+     case 0x03:
+          I2CSIM_Bmx280Convert(dev);
+          break;
+     default:
+          if(dev->converting && nowUs >= dev->convDoneUs){
+               dev->converting = false;
+               I2CSIM_Bmx280Convert(dev);
+               dev->regs[BMX280_REG_CTRL_MEAS] &= ~0x03;
+          }
+          break;
+     }
+
+     dev->regs[BMX280_REG_STATUS] = dev->converting ? 0x08 : 0x00;
+}
+
+static void I2CSIM_End(I2CSIM_device_t *dev){
+
+     if(dev->part != I2CSIM_ADXL345 || !dev->dataRead){
+          return;
+     }
+
+     dev->dataRead = false;
+     dev->overrun  = false;
+
+     if((dev->regs[ADXL_REG_FIFO_CTL] >> 6) == 0){
+          dev->newData = false;
+     }else if(dev->fifoCount > 0){
+          memcpy(dev->lastOut, dev->fifo[dev->fifoHead], sizeof(dev->lastOut));
+          dev->fifoHead = (dev->fifoHead + 1) % I2CSIM_ADXL_FIFO_DEPTH;
+          dev->fifoCount--;
+     }
+
+     I2CSIM_AdxlUpdate(dev, I2CSIM_NowUs());
+}
+
+static uint8_t I2CSIM_RegRead(I2CSIM_device_t *dev, uint8_t reg){
+
+     uint8_t data = dev->regs[reg];
+
+     if(dev->part == I2CSIM_ADXL345){
+          if(reg >= ADXL_REG_DATAX0 && reg <= ADXL_REG_DATAZ1){
+               dev->dataRead = true;
+          }else if(reg == ADXL_REG_INT_SOURCE){
+               /* Event bits other than data ready, watermark and overrun clear on read */
+               dev->regs[ADXL_REG_INT_SOURCE] &= (ADXL_INT_DATA_READY | ADXL_INT_WATERMARK | ADXL_INT_OVERRUN);
+          }
+     }
+     return data;
+}
+
+static void I2CSIM_RegWrite(I2CSIM_device_t *dev, uint8_t reg, uint8_t data){
+
+     if(dev->part == I2CSIM_ADXL345){
+          bool writable = (reg >= 0x1D && reg <= 0x2A) || (reg >= ADXL_REG_BW_RATE && reg <= 0x2F) ||
+                          reg == ADXL_REG_DATA_FORMAT || reg == ADXL_REG_FIFO_CTL;
+
+          if(writable){
+               if(reg == ADXL_REG_FIFO_CTL && (data >> 6) != (dev->regs[reg] >> 6)){
+                    dev->fifoHead  = 0;
+                    dev->fifoCount = 0;
+               }
+               /* Entering measurement restarts detection with the part awake */
+               if(reg == ADXL_REG_POWER_CTL && (data & ADXL_POWER_MEASURE) && !(dev->regs[reg] & ADXL_POWER_MEASURE)){
+                    dev->motionAwake = true;
+                    dev->motionRef   = false;
+                    dev->inactUs     = 0;
+                    dev->inactFired  = false;
+                    dev->regs[ADXL_REG_ACT_TAP_STATUS] &= ~ADXL_STATUS_ASLEEP;
+               }
+               dev->regs[reg] = data;
+          }
+          return;
+     }
+
+     switch (reg)
+     {
+     case BMX280_REG_RESET:
+          if(data == BMX280_RESET_WORD){
+               I2CSIM_PowerOn(dev);
+          }
+          break;
+     case BMX280_REG_CTRL_HUM:
+          if(dev->part == I2CSIM_BME280){
+               dev->regs[reg] = data & 0x07;
+          }
+          break;
+     case BMX280_REG_CONFIG:
+          dev->regs[reg] = data & 0xFD;
+          break;
+     case BMX280_REG_CTRL_MEAS:
+          dev->regs[reg] = data;
+          dev->osrsHum = dev->regs[BMX280_REG_CTRL_HUM];
+          if((data & 0x03) == 0x01 || (data & 0x03) == 0x02){
+               dev->converting = true;
+               dev->convDoneUs = I2CSIM_NowUs() + I2CSIM_Bmx280MeasUs(dev);
+               dev->regs[BMX280_REG_STATUS] = 0x08;
+          }
+          break;
+     default:
+          break;
+     }
+}
+
+static esp_err_t I2CSIM_SpiExecute(struct spi_device_t *spi, spi_transaction_t *trans){
+
+     size_t         rxBits = (trans->rxlength != 0) ? trans->rxlength : trans->length;
+     size_t         len = trans->length / 8;
+     const uint8_t *tx;
+     uint8_t       *rx;
+     uint8_t        cmd;
+     I2CSIM_device_t *dev;
+     uint64_t       busNs;
+
+     if((trans->length % 8) != 0 || rxBits > trans->length ||
+        ((trans->flags & (SPI_TRANS_USE_RXDATA | SPI_TRANS_USE_TXDATA)) && trans->length > 32)){
+          return ESP_ERR_INVALID_ARG;
+     }
+     tx = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data : trans->tx_buffer;
+     rx = (trans->flags & SPI_TRANS_USE_RXDATA) ? trans->rx_data : trans->rx_buffer;
+
+     pthread_mutex_lock(&simLock);
+
+     dev = I2CSIM_Find(I2CSIM_SPI_PORT(spi->host), (uint8_t)spi->conf.spics_io_num);
+
+     /* The ADXL345 header byte is the address phase, or the first data byte
+        when the device has no address phase */
+     if(spi->conf.address_bits == 8){
+          cmd = (uint8_t)trans->addr;
+     }else
+     {
+          cmd = (tx != NULL && len != 0) ? tx[0] : 0;
+          if(len != 0){
+               tx  = (tx != NULL) ? tx + 1 : NULL;
+               if(rx != NULL){
+                    rx[0] = 0xFF;
+                    rx++;
+               }
+               len--;
+          }
+     }
+
+     if(dev == NULL || spi->conf.mode != ADXL_SPI_MODE || spi->conf.clock_speed_hz > ADXL_SPI_CLK_MAX){
+          /* Nobody drives MISO, or the part samples at the wrong edge */
+          if(rx != NULL){
+               memset(rx, 0xFF, len);
+          }
+     }else
+     {
+          uint8_t reg = cmd & 0x3F;
+
+          I2CSIM_Begin(dev, I2CSIM_NowUs());
+          for(size_t i = 0; i < len; i++){
+               if(cmd & ADXL_SPI_READ){
+                    uint8_t data = I2CSIM_RegRead(dev, reg);
+
+                    if(rx != NULL && i * 8 < rxBits){
+                         rx[i] = data;
+                    }
+               }else
+               {
+                    I2CSIM_RegWrite(dev, reg, (tx != NULL) ? tx[i] : 0);
+               }
+               if(cmd & ADXL_SPI_MB){
+                    reg = (reg + 1) & 0x3F;
+               }
+          }
+          I2CSIM_End(dev);
+     }
+
+     busNs = (uint64_t)(spi->conf.address_bits + trans->length) * 1000000000ULL / spi->conf.clock_speed_hz +
+             SPI_TRANS_OVERHEAD_NS;
+     simSpiBus[spi->host].busTimeNs += busNs;
+     if(!simRealTime){
+          simVirtualNs += busNs;
+     }
+
+     pthread_mutex_unlock(&simLock);
+
+     if(simRealTime){
+          usleep((useconds_t)(busNs / 1000));
+     }
+
+     return ESP_OK;
+}
+
+static I2CSIM_cmd_t *I2CSIM_Append(I2CSIM_link_t *link){
+
+     if(link == NULL){
+          return NULL;
+     }
+
+     if(link->count == link->cap){
+          size_t cap = link->cap ? link->cap * 2 : 16;
+          I2CSIM_cmd_t *cmds = realloc(link->cmds, cap * sizeof(I2CSIM_cmd_t));
+
+          if(cmds == NULL){
+               return NULL;
+          }
+          link->cmds = cmds;
+          link->cap  = cap;
+     }
+
+     memset(&link->cmds[link->count], 0, sizeof(I2CSIM_cmd_t));
+
+     return &link->cmds[link->count++];
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+void I2CSIM_Reset(void){
+
+     pthread_mutex_lock(&simLock);
+     memset(simDevices, 0, sizeof(simDevices));
+     memset(simBus, 0, sizeof(simBus));
+     simRealTime = false;
+     simVirtualNs = 0;
+     memset(simIsr, 0, sizeof(simIsr));
+     simIsrService = false;
+     memset(simSpiDevices, 0, sizeof(simSpiDevices));
+     memset(simSpiBus, 0, sizeof(simSpiBus));
+     pthread_mutex_unlock(&simLock);
+}
+
+esp_err_t I2CSIM_AddDevice(i2c_port_t port, uint8_t addr, I2CSIM_part_e part){
+
+     esp_err_t err = ESP_ERR_NO_MEM;
+
+     if(port < 0 || port >= I2CSIM_SPI_PORT(SPI_HOST_MAX)){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     pthread_mutex_lock(&simLock);
+
+     for(int i = 0; i < I2CSIM_MAX_DEVICES; i++){
+          I2CSIM_device_t *dev = &simDevices[i];
+
+          if(!dev->used){
+               memset(dev, 0, sizeof(*dev));
+               dev->used     = true;
+               dev->port     = port;
+               dev->addr     = addr;
+               dev->part     = part;
+               dev->intGpio[0] = -1;
+               dev->intGpio[1] = -1;
+               dev->rawPress = DEFAULT_RAW_PRESS;
+               dev->rawTemp  = DEFAULT_RAW_TEMP;
+               dev->rawHum   = DEFAULT_RAW_HUM;
+               dev->lastSampleUs = I2CSIM_NowUs();
+               I2CSIM_PowerOn(dev);
+               err = ESP_OK;
+               break;
+          }
+     }
+
+     pthread_mutex_unlock(&simLock);
+
+     return err;
+}
+
+esp_err_t I2CSIM_AddSpiDevice(spi_host_device_t host, int csIo, I2CSIM_part_e part){
+
+     if(host < 0 || host >= SPI_HOST_MAX || csIo < 0 || csIo >= SIM_GPIO_COUNT || part != I2CSIM_ADXL345){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     return I2CSIM_AddDevice(I2CSIM_SPI_PORT(host), (uint8_t)csIo, part);
+}
+
+uint64_t I2CSIM_SpiBusTimeNs(spi_host_device_t host){
+
+     return (host >= 0 && host < SPI_HOST_MAX) ? simSpiBus[host].busTimeNs : 0;
+}
+
+void I2CSIM_SetLatency(i2c_port_t port, uint32_t latencyUs){
+
+     if(port >= 0 && port < I2C_NUM_MAX){
+          simBus[port].latencyUs = latencyUs;
+     }
+}
+
+void I2CSIM_SetRealTime(bool enable){
+
+     simRealTime = enable;
+}
+
+esp_err_t I2CSIM_SetClockStretch(i2c_port_t port, uint8_t addr, uint32_t stretchUs){
+
+     esp_err_t err = ESP_ERR_NOT_FOUND;
+     I2CSIM_device_t *dev;
+
+     pthread_mutex_lock(&simLock);
+     dev = I2CSIM_Find(port, addr);
+     if(dev != NULL){
+          dev->stretchUs = stretchUs;
+          err = ESP_OK;
+     }
+     pthread_mutex_unlock(&simLock);
+
+     return err;
+}
+
+esp_err_t I2CSIM_InjectNack(i2c_port_t port, uint8_t addr, uint32_t count){
+
+     esp_err_t err = ESP_ERR_NOT_FOUND;
+     I2CSIM_device_t *dev;
+
+     pthread_mutex_lock(&simLock);
+     dev = I2CSIM_Find(port, addr);
+     if(dev != NULL){
+          dev->nackCount = count;
+          err = ESP_OK;
+     }
+     pthread_mutex_unlock(&simLock);
+
+     return err;
+}
+
+esp_err_t I2CSIM_SetMaxClock(i2c_port_t port, uint8_t addr, uint32_t clkSpeed){
+
+     esp_err_t err = ESP_ERR_NOT_FOUND;
+     I2CSIM_device_t *dev;
+
+     pthread_mutex_lock(&simLock);
+     dev = I2CSIM_Find(port, addr);
+     if(dev != NULL){
+          dev->maxClkSpeed = clkSpeed;
+          err = ESP_OK;
+     }
+     pthread_mutex_unlock(&simLock);
+
+     return err;
+}
+
+esp_err_t I2CSIM_StickSda(i2c_port_t port, uint32_t clocks){
+
+     if(port < 0 || port >= I2C_NUM_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     pthread_mutex_lock(&simLock);
+     simBus[port].sdaHeldClocks = clocks;
+     pthread_mutex_unlock(&simLock);
+
+     return ESP_OK;
+}
+
+esp_err_t I2CSIM_SetAdxlIntPins(i2c_port_t port, uint8_t addr, int int1Gpio, int int2Gpio){
+
+     esp_err_t err = ESP_ERR_NOT_FOUND;
+     I2CSIM_device_t *dev;
+
+     pthread_mutex_lock(&simLock);
+     dev = I2CSIM_Find(port, addr);
+     if(dev != NULL && dev->part == I2CSIM_ADXL345){
+          dev->intGpio[0] = int1Gpio;
+          dev->intGpio[1] = int2Gpio;
+          dev->intLevel[0] = false;
+          dev->intLevel[1] = false;
+          err = ESP_OK;
+     }
+     pthread_mutex_unlock(&simLock);
+
+     return err;
+}
+
+int I2CSIM_ServiceInterrupts(void){
+
+     I2CSIM_isr_t fire[I2CSIM_MAX_DEVICES * 2];
+     int fired = 0;
+
+     pthread_mutex_lock(&simLock);
+
+     for(int i = 0; i < I2CSIM_MAX_DEVICES; i++){
+          I2CSIM_device_t *dev = &simDevices[i];
+          uint8_t active;
+
+          if(!dev->used || dev->part != I2CSIM_ADXL345){
+               continue;
+          }
+
+          I2CSIM_AdxlUpdate(dev, I2CSIM_NowUs());
+          active = dev->regs[ADXL_REG_INT_SOURCE] & dev->regs[ADXL_REG_INT_ENABLE];
+
+          for(int pin = 0; pin < 2; pin++){
+               int  gpio = dev->intGpio[pin];
+               bool level = ((pin == 0) ? (active & ~dev->regs[ADXL_REG_INT_MAP]) : (active & dev->regs[ADXL_REG_INT_MAP])) != 0;
+
+               if(gpio < 0 || gpio >= SIM_GPIO_COUNT){
+                    continue;
+               }
+               /* Edge into the asserted state, INT_INVERT only changes the electrical level */
+               if(level && !dev->intLevel[pin] && simIsrService && simIsr[gpio].enabled && simIsr[gpio].handler != NULL){
+                    fire[fired++] = simIsr[gpio];
+               }
+               dev->intLevel[pin] = level;
+          }
+     }
+
+     pthread_mutex_unlock(&simLock);
+
+     for(int i = 0; i < fired; i++){
+          fire[i].handler(fire[i].arg);
+     }
+
+     return fired;
+}
+
+esp_err_t I2CSIM_SetBmx280Raw(i2c_port_t port, uint8_t addr, int32_t press, int32_t temp, int32_t hum){
+
+     esp_err_t err = ESP_ERR_NOT_FOUND;
+     I2CSIM_device_t *dev;
+
+     pthread_mutex_lock(&simLock);
+     dev = I2CSIM_Find(port, addr);
+     if(dev != NULL && dev->part != I2CSIM_ADXL345){
+          dev->rawPress = press & 0xFFFFF;
+          dev->rawTemp  = temp & 0xFFFFF;
+          dev->rawHum   = hum & 0xFFFF;
+          err = ESP_OK;
+     }
+     pthread_mutex_unlock(&simLock);
+
+     return err;
+}
+
+esp_err_t I2CSIM_SetAdxlSource(i2c_port_t port, uint8_t addr, I2CSIM_adxlSource_t source, void *arg){
+
+     esp_err_t err = ESP_ERR_NOT_FOUND;
+     I2CSIM_device_t *dev;
+
+     pthread_mutex_lock(&simLock);
+     dev = I2CSIM_Find(port, addr);
+     if(dev != NULL && dev->part == I2CSIM_ADXL345){
+          dev->source      = source;
+          dev->sourceArg   = arg;
+          dev->sampleIndex = 0;
+          err = ESP_OK;
+     }
+     pthread_mutex_unlock(&simLock);
+
+     return err;
+}
+
+esp_err_t I2CSIM_PeekReg(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t *data){
+
+     esp_err_t err = ESP_ERR_NOT_FOUND;
+     I2CSIM_device_t *dev;
+
+     pthread_mutex_lock(&simLock);
+     dev = I2CSIM_Find(port, addr);
+     if(dev != NULL){
+          *data = dev->regs[reg];
+          err = ESP_OK;
+     }
+     pthread_mutex_unlock(&simLock);
+
+     return err;
+}
+
+int64_t esp_timer_get_time(void){
+
+     return I2CSIM_NowUs();
+}
+
+uint64_t I2CSIM_BusTimeNs(i2c_port_t port){
+
+     return (port >= 0 && port < I2C_NUM_MAX) ? simBus[port].busTimeNs : 0;
+}
+
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t *i2c_conf){
+
+     if(i2c_num < 0 || i2c_num >= I2C_NUM_MAX || i2c_conf == NULL || i2c_conf->master.clk_speed == 0){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     simBus[i2c_num].clkSpeed = i2c_conf->master.clk_speed;
+     simBus[i2c_num].sdaIo = i2c_conf->sda_io_num;
+     simBus[i2c_num].sclIo = i2c_conf->scl_io_num;
+
+     return ESP_OK;
+}
+
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len, int intr_alloc_flags){
+
+     bool populated = false;
+
+     if(i2c_num < 0 || i2c_num >= I2C_NUM_MAX || mode != I2C_MODE_MASTER){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     if(simBus[i2c_num].installed){
+          return ESP_FAIL;
+     }
+
+     simBus[i2c_num].installed = true;
+     if(simBus[i2c_num].clkSpeed == 0){
+          simBus[i2c_num].clkSpeed = DEFAULT_CLK_SPEED;
+     }
+
+     for(int i = 0; i < I2CSIM_MAX_DEVICES; i++){
+          populated |= simDevices[i].used && simDevices[i].port == i2c_num;
+     }
+
+     if(!populated){
+          I2CSIM_AddDevice(i2c_num, 0x76, I2CSIM_BME280);
+          I2CSIM_AddDevice(i2c_num, 0x77, I2CSIM_BMP280);
+          I2CSIM_AddDevice(i2c_num, 0x53, I2CSIM_ADXL345);
+     }
+
+     return ESP_OK;
+}
+
+esp_err_t i2c_driver_delete(i2c_port_t i2c_num){
+
+     if(i2c_num < 0 || i2c_num >= I2C_NUM_MAX || !simBus[i2c_num].installed){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     simBus[i2c_num].installed = false;
+
+     return ESP_OK;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void){
+
+     return calloc(1, sizeof(I2CSIM_link_t));
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle){
+
+     I2CSIM_link_t *link = cmd_handle;
+
+     if(link != NULL){
+          free(link->cmds);
+          free(link);
+     }
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle){
+
+     I2CSIM_cmd_t *cmd = I2CSIM_Append(cmd_handle);
+
+     if(cmd == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+     cmd->type = CMD_START;
+
+     return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle){
+
+     I2CSIM_cmd_t *cmd = I2CSIM_Append(cmd_handle);
+
+     if(cmd == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+     cmd->type = CMD_STOP;
+
+     return ESP_OK;
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en){
+
+     I2CSIM_cmd_t *cmd = I2CSIM_Append(cmd_handle);
+
+     if(cmd == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+     cmd->type = CMD_WRITE;
+     cmd->byte = data;
+     cmd->len  = 1;
+
+     return ESP_OK;
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, const uint8_t *data, size_t data_len, bool ack_en){
+
+     I2CSIM_cmd_t *cmd;
+
+     if(data == NULL && data_len != 0){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     cmd = I2CSIM_Append(cmd_handle);
+     if(cmd == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+     cmd->type = CMD_WRITE;
+     cmd->tx   = data;
+     cmd->len  = data_len;
+
+     return ESP_OK;
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd_handle, uint8_t *data, size_t data_len, i2c_ack_type_t ack){
+
+     I2CSIM_cmd_t *cmd;
+
+     if(data == NULL || data_len == 0){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     cmd = I2CSIM_Append(cmd_handle);
+     if(cmd == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+     cmd->type = CMD_READ;
+     cmd->rx   = data;
+     cmd->len  = data_len;
+
+     return ESP_OK;
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait){
+
+     I2CSIM_link_t   *link = cmd_handle;
+     I2CSIM_device_t *dev = NULL;
+     esp_err_t err = ESP_OK;
+     bool      expectAddr = false;
+     bool      regPhase = false;
+     bool      pairWrite = false;
+     bool      reading = false;
+     uint64_t  bits = 0;
+     uint64_t  stretchUs = 0;
+     uint64_t  timeoutUs = (uint64_t)ticks_to_wait * portTICK_PERIOD_MS * 1000;
+     uint64_t  busNs;
+
+     if(i2c_num < 0 || i2c_num >= I2C_NUM_MAX || link == NULL){
+          return ESP_ERR_INVALID_ARG;
+     }
+     if(!simBus[i2c_num].installed){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     pthread_mutex_lock(&simLock);
+
+     /* SDA held low, the controller can not generate a start until the timeout */
+     if(simBus[i2c_num].sdaHeldClocks != 0){
+          err = ESP_ERR_TIMEOUT;
+          stretchUs = timeoutUs;
+     }
+
+     for(size_t c = 0; c < link->count && err == ESP_OK; c++){
+          I2CSIM_cmd_t  *cmd = &link->cmds[c];
+          const uint8_t *tx = (cmd->tx != NULL) ? cmd->tx : &cmd->byte;
+
+          switch (cmd->type)
+          {
+          case CMD_START:
+               if(dev != NULL){
+                    I2CSIM_End(dev);
+               }
+               expectAddr = true;
+               bits += 1;
+               break;
+
+          case CMD_STOP:
+               if(dev != NULL){
+                    I2CSIM_End(dev);
+               }
+               dev = NULL;
+               bits += 1;
+               break;
+
+          case CMD_WRITE:
+               for(size_t i = 0; i < cmd->len && err == ESP_OK; i++){
+                    bits += 9;
+                    if(expectAddr){
+                         expectAddr = false;
+                         dev = I2CSIM_Find(i2c_num, tx[i] >> 1);
+                         if(dev == NULL){
+                              err = ESP_FAIL;
+                         }else if(dev->nackCount > 0){
+                              dev->nackCount--;
+                              dev = NULL;
+                              err = ESP_FAIL;
+                         }else if(dev->maxClkSpeed != 0 && simBus[i2c_num].clkSpeed > dev->maxClkSpeed){
+                              dev = NULL;
+                              err = ESP_FAIL;
+                         }else
+                         {
+                              reading   = (tx[i] & 0x01) == I2C_MASTER_READ;
+                              regPhase  = true;
+                              pairWrite = (dev->part != I2CSIM_ADXL345);
+                              stretchUs += dev->stretchUs;
+                              I2CSIM_Begin(dev, I2CSIM_NowUs());
+                         }
+                    }else if(dev == NULL || reading){
+                         err = ESP_FAIL;
+                    }else if(regPhase){
+                         dev->regPtr = tx[i];
+                         regPhase = false;
+                    }else
+                    {
+                         /* BMx280 takes register/data pairs, the ADXL345 auto-increments */
+                         I2CSIM_RegWrite(dev, dev->regPtr, tx[i]);
+                         if(pairWrite){
+                              regPhase = true;
+                         }else
+                         {
+                              dev->regPtr++;
+                         }
+                    }
+               }
+               break;
+
+          case CMD_READ:
+               if(dev == NULL || !reading){
+                    err = ESP_FAIL;
+                    break;
+               }
+               for(size_t i = 0; i < cmd->len; i++){
+                    cmd->rx[i] = I2CSIM_RegRead(dev, dev->regPtr++);
+               }
+               bits += 9 * cmd->len;
+               break;
+          }
+     }
+
+     if(dev != NULL){
+          I2CSIM_End(dev);
+     }
+
+     if(err == ESP_OK && timeoutUs != 0 && stretchUs > timeoutUs){
+          stretchUs = timeoutUs;
+          err = ESP_ERR_TIMEOUT;
+     }
+
+     busNs = bits * 1000000000ULL / simBus[i2c_num].clkSpeed + (simBus[i2c_num].latencyUs + stretchUs) * 1000ULL;
+     simBus[i2c_num].busTimeNs += busNs;
+     if(!simRealTime){
+          simVirtualNs += busNs;
+     }
+
+     pthread_mutex_unlock(&simLock);
+
+     if(simRealTime){
+          usleep((useconds_t)(busNs / 1000));
+     }
+
+     return err;
+}
+
+esp_err_t i2c_master_write_to_device(i2c_port_t i2c_num, uint8_t device_address, const uint8_t *write_buffer, size_t write_size, TickType_t ticks_to_wait){
+
+     esp_err_t err;
+     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+
+     if(cmd == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+
+     i2c_master_start(cmd);
+     i2c_master_write_byte(cmd, (device_address << 1) | I2C_MASTER_WRITE, true);
+     i2c_master_write(cmd, write_buffer, write_size, true);
+     i2c_master_stop(cmd);
+     err = i2c_master_cmd_begin(i2c_num, cmd, ticks_to_wait);
+     i2c_cmd_link_delete(cmd);
+
+     return err;
+}
+
+esp_err_t i2c_master_read_from_device(i2c_port_t i2c_num, uint8_t device_address, uint8_t *read_buffer, size_t read_size, TickType_t ticks_to_wait){
+
+     esp_err_t err;
+     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+
+     if(cmd == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+
+     i2c_master_start(cmd);
+     i2c_master_write_byte(cmd, (device_address << 1) | I2C_MASTER_READ, true);
+     i2c_master_read(cmd, read_buffer, read_size, I2C_MASTER_LAST_NACK);
+     i2c_master_stop(cmd);
+     err = i2c_master_cmd_begin(i2c_num, cmd, ticks_to_wait);
+     i2c_cmd_link_delete(cmd);
+
+     return err;
+}
+
+esp_err_t i2c_master_write_read_device(i2c_port_t i2c_num, uint8_t device_address, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size, TickType_t ticks_to_wait){
+
+     esp_err_t err;
+     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+
+     if(cmd == NULL){
+          return ESP_ERR_NO_MEM;
+     }
+
+     i2c_master_start(cmd);
+     i2c_master_write_byte(cmd, (device_address << 1) | I2C_MASTER_WRITE, true);
+     i2c_master_write(cmd, write_buffer, write_size, true);
+     i2c_master_start(cmd);
+     i2c_master_write_byte(cmd, (device_address << 1) | I2C_MASTER_READ, true);
+     i2c_master_read(cmd, read_buffer, read_size, I2C_MASTER_LAST_NACK);
+     i2c_master_stop(cmd);
+     err = i2c_master_cmd_begin(i2c_num, cmd, ticks_to_wait);
+     i2c_cmd_link_delete(cmd);
+
+     return err;
+}
+
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig){
+
+     pthread_mutex_lock(&simLock);
+     for(int i = 0; i < SIM_GPIO_COUNT; i++){
+          if(pGPIOConfig->pin_bit_mask & (1ULL << i)){
+               simIsr[i].enabled = (pGPIOConfig->intr_type != GPIO_INTR_DISABLE);
+          }
+     }
+     pthread_mutex_unlock(&simLock);
+
+     return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags){
+
+     esp_err_t err = ESP_OK;
+
+     pthread_mutex_lock(&simLock);
+     if(simIsrService){
+          err = ESP_ERR_INVALID_STATE;
+     }
+     simIsrService = true;
+     pthread_mutex_unlock(&simLock);
+
+     return err;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args){
+
+     if(gpio_num < 0 || gpio_num >= SIM_GPIO_COUNT){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     pthread_mutex_lock(&simLock);
+     simIsr[gpio_num].handler = isr_handler;
+     simIsr[gpio_num].arg     = args;
+     pthread_mutex_unlock(&simLock);
+
+     return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num){
+
+     return gpio_isr_handler_add(gpio_num, NULL, NULL);
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num){
+
+     return gpio_set_level(gpio_num, 1);
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode){
+
+     return ESP_OK;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull){
+
+     return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level){
+
+     pthread_mutex_lock(&simLock);
+
+     for(int i = 0; i < I2C_NUM_MAX; i++){
+          if(simBus[i].sclIo != gpio_num || simBus[i].installed){
+               continue;
+          }
+          /* Each released SCL pulse shifts out one bit of the stuck slave */
+          if(simBus[i].sclLow && level != 0 && simBus[i].sdaHeldClocks != 0){
+               simBus[i].sdaHeldClocks--;
+          }
+          simBus[i].sclLow = (level == 0);
+     }
+
+     pthread_mutex_unlock(&simLock);
+
+     return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num){
+
+     int level = 1;
+
+     pthread_mutex_lock(&simLock);
+
+     for(int i = 0; i < I2C_NUM_MAX; i++){
+          if(simBus[i].sdaIo == gpio_num && simBus[i].sdaHeldClocks != 0){
+               level = 0;
+          }
+          if(simBus[i].sclIo == gpio_num && simBus[i].sclLow){
+               level = 0;
+          }
+     }
+
+     pthread_mutex_unlock(&simLock);
+
+     return level;
+}
+
+void esp_rom_delay_us(uint32_t us){
+
+     if(simRealTime){
+          usleep(us);
+     }else
+     {
+          pthread_mutex_lock(&simLock);
+          simVirtualNs += (uint64_t)us * 1000;
+          pthread_mutex_unlock(&simLock);
+     }
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host_id, const spi_bus_config_t *bus_config, spi_common_dma_t dma_chan){
+
+     if(host_id <= SPI1_HOST || host_id >= SPI_HOST_MAX || bus_config == NULL){
+          return ESP_ERR_INVALID_ARG;
+     }
+     if(simSpiBus[host_id].initialized){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     simSpiBus[host_id].initialized = true;
+
+     return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host_id){
+
+     if(host_id < 0 || host_id >= SPI_HOST_MAX || !simSpiBus[host_id].initialized){
+          return ESP_ERR_INVALID_STATE;
+     }
+     for(int i = 0; i < I2CSIM_MAX_DEVICES; i++){
+          if(simSpiDevices[i].used && simSpiDevices[i].host == host_id){
+               return ESP_ERR_INVALID_STATE;
+          }
+     }
+
+     simSpiBus[host_id].initialized = false;
+
+     return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle){
+
+     if(host_id < 0 || host_id >= SPI_HOST_MAX || dev_config == NULL || handle == NULL ||
+        dev_config->clock_speed_hz <= 0 || dev_config->queue_size <= 0 || dev_config->queue_size > I2CSIM_SPI_QUEUE_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+     if(!simSpiBus[host_id].initialized){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     for(int i = 0; i < I2CSIM_MAX_DEVICES; i++){
+          struct spi_device_t *spi = &simSpiDevices[i];
+
+          if(!spi->used){
+               memset(spi, 0, sizeof(*spi));
+               spi->used = true;
+               spi->host = host_id;
+               spi->conf = *dev_config;
+               *handle = spi;
+               return ESP_OK;
+          }
+     }
+
+     return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle){
+
+     if(handle == NULL || !handle->used || handle->count != 0){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     handle->used = false;
+
+     return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait){
+
+     esp_err_t err;
+
+     if(handle == NULL || trans_desc == NULL){
+          return ESP_ERR_INVALID_ARG;
+     }
+     if(handle->count == handle->conf.queue_size){
+          return ESP_ERR_TIMEOUT;
+     }
+
+     err = I2CSIM_SpiExecute(handle, trans_desc);
+     if(err == ESP_OK){
+          handle->queue[(handle->head + handle->count) % I2CSIM_SPI_QUEUE_MAX] = trans_desc;
+          handle->count++;
+     }
+
+     return err;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, TickType_t ticks_to_wait){
+
+     if(handle == NULL || trans_desc == NULL){
+          return ESP_ERR_INVALID_ARG;
+     }
+     if(handle->count == 0){
+          return ESP_ERR_TIMEOUT;
+     }
+
+     *trans_desc = handle->queue[handle->head];
+     handle->head = (handle->head + 1) % I2CSIM_SPI_QUEUE_MAX;
+     handle->count--;
+
+     return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc){
+
+     if(handle == NULL || trans_desc == NULL){
+          return ESP_ERR_INVALID_ARG;
+     }
+     /* Queued transactions must be collected first, as on the target */
+     if(handle->count != 0){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     return I2CSIM_SpiExecute(handle, trans_desc);
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc){
+
+     return spi_device_transmit(handle, trans_desc);
+}
@@ -0,0 +1,92 @@
+/**
+ * \file gpio.h
+ * \author Ugurcan OZTURK
+ * \brief	Linux Host GPIO Driver Subset Header File
+ * \date 17.10.2026
+ *
+ * Declares the subset of the ESP-IDF GPIO API used by the sensors
+ * component. On the linux target it is implemented by i2csim.c, where the
+ * I2C pins of a simulated bus respond to a bus clear and ISRs run from
+ * I2CSIM_ServiceInterrupts().
+ */
+
+#ifndef I2CSIM_DRIVER_GPIO_H_
+#define I2CSIM_DRIVER_GPIO_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "esp_err.h"
+
+
+/******************************************************************************
+ *** ENUMS
+ ******************************************************************************/
+typedef int gpio_num_t;
+
+typedef enum{
+    GPIO_PULLUP_DISABLE,
+    GPIO_PULLUP_ENABLE
+}gpio_pullup_t;
+
+typedef enum{
+    GPIO_MODE_DISABLE,
+    GPIO_MODE_INPUT,
+    GPIO_MODE_OUTPUT,
+    GPIO_MODE_OUTPUT_OD,
+    GPIO_MODE_INPUT_OUTPUT_OD,
+    GPIO_MODE_INPUT_OUTPUT
+}gpio_mode_t;
+
+typedef enum{
+    GPIO_PULLDOWN_DISABLE,
+    GPIO_PULLDOWN_ENABLE
+}gpio_pulldown_t;
+
+typedef enum{
+    GPIO_INTR_DISABLE,
+    GPIO_INTR_POSEDGE,
+    GPIO_INTR_NEGEDGE,
+    GPIO_INTR_ANYEDGE,
+    GPIO_INTR_LOW_LEVEL,
+    GPIO_INTR_HIGH_LEVEL
+}gpio_int_type_t;
+
+typedef enum{
+    GPIO_PULLUP_ONLY,
+    GPIO_PULLDOWN_ONLY,
+    GPIO_PULLUP_PULLDOWN,
+    GPIO_FLOATING
+}gpio_pull_mode_t;
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+typedef struct{
+
+    uint64_t        pin_bit_mask;
+    gpio_mode_t     mode;
+    gpio_pullup_t   pull_up_en;
+    gpio_pulldown_t pull_down_en;
+    gpio_int_type_t intr_type;
+}gpio_config_t;
+
+typedef void (*gpio_isr_t)(void *arg);
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig);
+esp_err_t gpio_install_isr_service(int intr_alloc_flags);
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args);
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num);
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num);
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode);
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull);
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
+int gpio_get_level(gpio_num_t gpio_num);
+
+#endif /* I2CSIM_DRIVER_GPIO_H_ */
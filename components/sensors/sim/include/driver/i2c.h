@@ -0,0 +1,96 @@
+/**
+ * \file i2c.h
+ * \author Ugurcan OZTURK
+ * \brief	Linux Host I2C Master Driver Subset Header File
+ * \date 17.10.2026
+ *
+ * Declares the subset of the ESP-IDF legacy I2C master API used by the
+ * sensors component. On the linux target it is implemented by i2csim.c.
+ */
+
+#ifndef I2CSIM_DRIVER_I2C_H_
+#define I2CSIM_DRIVER_I2C_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    I2C_NUM_0                 0
+#define    I2C_NUM_1                 1
+#define    I2C_NUM_MAX               2
+
+
+/******************************************************************************
+ *** ENUMS
+ ******************************************************************************/
+typedef int i2c_port_t;
+
+typedef enum{
+    I2C_MODE_SLAVE,
+    I2C_MODE_MASTER
+}i2c_mode_t;
+
+typedef enum{
+    I2C_MASTER_WRITE,
+    I2C_MASTER_READ
+}i2c_rw_t;
+
+typedef enum{
+    I2C_MASTER_ACK,
+    I2C_MASTER_NACK,
+    I2C_MASTER_LAST_NACK
+}i2c_ack_type_t;
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+typedef struct{
+
+    i2c_mode_t    mode;
+    int           sda_io_num;
+    int           scl_io_num;
+    gpio_pullup_t sda_pullup_en;
+    gpio_pullup_t scl_pullup_en;
+    union {
+        struct {
+            uint32_t clk_speed;
+        }master;
+    };
+    uint32_t      clk_flags;
+}i2c_config_t;
+
+typedef void *i2c_cmd_handle_t;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t *i2c_conf);
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len, int intr_alloc_flags);
+esp_err_t i2c_driver_delete(i2c_port_t i2c_num);
+
+i2c_cmd_handle_t i2c_cmd_link_create(void);
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en);
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, const uint8_t *data, size_t data_len, bool ack_en);
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd_handle, uint8_t *data, size_t data_len, i2c_ack_type_t ack);
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait);
+
+esp_err_t i2c_master_write_to_device(i2c_port_t i2c_num, uint8_t device_address, const uint8_t *write_buffer, size_t write_size, TickType_t ticks_to_wait);
+esp_err_t i2c_master_read_from_device(i2c_port_t i2c_num, uint8_t device_address, uint8_t *read_buffer, size_t read_size, TickType_t ticks_to_wait);
+esp_err_t i2c_master_write_read_device(i2c_port_t i2c_num, uint8_t device_address, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size, TickType_t ticks_to_wait);
+
+#endif /* I2CSIM_DRIVER_I2C_H_ */
@@ -0,0 +1,117 @@
+/**
+ * \file spi_master.h
+ * \author Ugurcan OZTURK
+ * \brief	Linux Host SPI Master Driver Subset Header File
+ * \date 17.10.2026
+ *
+ * Declares the subset of the ESP-IDF SPI master API used by the sensors
+ * component. On the linux target it is implemented by i2csim.c, where a
+ * device added with I2CSIM_AddSpiDevice() answers on its host and CS pin.
+ * Queued transactions complete at queue time and wait for
+ * spi_device_get_trans_result() in order.
+ */
+
+#ifndef I2CSIM_DRIVER_SPI_MASTER_H_
+#define I2CSIM_DRIVER_SPI_MASTER_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    SPI_TRANS_USE_RXDATA      (1 << 2)
+#define    SPI_TRANS_USE_TXDATA      (1 << 3)
+#define    SPI_DEVICE_HALFDUPLEX     (1 << 4)
+
+
+/******************************************************************************
+ *** ENUMS
+ ******************************************************************************/
+typedef enum{
+    SPI1_HOST,
+    SPI2_HOST,
+    SPI3_HOST,
+    SPI_HOST_MAX
+}spi_host_device_t;
+
+typedef enum{
+    SPI_DMA_DISABLED,
+    SPI_DMA_CH1,
+    SPI_DMA_CH2,
+    SPI_DMA_CH_AUTO
+}spi_common_dma_t;
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+typedef struct{
+
+    int        mosi_io_num;
+    int        miso_io_num;
+    int        sclk_io_num;
+    int        quadwp_io_num;
+    int        quadhd_io_num;
+    int        max_transfer_sz;
+    uint32_t   flags;
+    int        intr_flags;
+}spi_bus_config_t;
+
+typedef struct{
+
+    uint8_t    command_bits;
+    uint8_t    address_bits;
+    uint8_t    dummy_bits;
+    uint8_t    mode;
+    uint16_t   cs_ena_pretrans;
+    uint8_t    cs_ena_posttrans;
+    int        clock_speed_hz;
+    int        input_delay_ns;
+    int        spics_io_num;
+    uint32_t   flags;
+    int        queue_size;
+    void     (*pre_cb)(void *trans);
+    void     (*post_cb)(void *trans);
+}spi_device_interface_config_t;
+
+typedef struct{
+
+    uint32_t   flags;
+    uint16_t   cmd;
+    uint64_t   addr;
+    size_t     length;        /* Data phase, bits */
+    size_t     rxlength;      /* Received bits, 0 for length */
+    void      *user;
+    union{
+        const void *tx_buffer;
+        uint8_t     tx_data[4];
+    };
+    union{
+        void       *rx_buffer;
+        uint8_t     rx_data[4];
+    };
+}spi_transaction_t;
+
+typedef struct spi_device_t *spi_device_handle_t;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+esp_err_t spi_bus_initialize(spi_host_device_t host_id, const spi_bus_config_t *bus_config, spi_common_dma_t dma_chan);
+esp_err_t spi_bus_free(spi_host_device_t host_id);
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, TickType_t ticks_to_wait);
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
+
+#endif /* I2CSIM_DRIVER_SPI_MASTER_H_ */
@@ -0,0 +1,19 @@
+/**
+ * \file esp_rom_sys.h
+ * \author Ugurcan OZTURK
+ * \brief	Linux Host ROM Delay Subset Header File
+ * \date 17.10.2026
+ */
+
+#ifndef I2CSIM_ESP_ROM_SYS_H_
+#define I2CSIM_ESP_ROM_SYS_H_
+
+#include <stdint.h>
+
+/** \brief  Busy wait, advances the simulator clock
+ * \param us Delay (us)
+ * \return  Nothing
+ */
+void esp_rom_delay_us(uint32_t us);
+
+#endif /* I2CSIM_ESP_ROM_SYS_H_ */
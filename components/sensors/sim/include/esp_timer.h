@@ -0,0 +1,19 @@
+/**
+ * \file esp_timer.h
+ * \author Ugurcan OZTURK
+ * \brief	Linux Host Timer Subset Header File
+ * \date 17.10.2026
+ */
+
+#ifndef I2CSIM_ESP_TIMER_H_
+#define I2CSIM_ESP_TIMER_H_
+
+#include <stdint.h>
+
+/** \brief  Simulator clock, host monotonic time plus virtual bus time
+ * \param[] Nothing
+ * \return  Time since start (us)
+ */
+int64_t esp_timer_get_time(void);
+
+#endif /* I2CSIM_ESP_TIMER_H_ */
@@ -0,0 +1,194 @@
+/**
+ * \file i2csim.h
+ * \author Ugurcan OZTURK
+ * \brief	Linux Host I2C Bus Simulator Header File
+ * \date 17.10.2026
+ *
+ * Register-level models of the BME280, BMP280 and ADXL345 behind the
+ * legacy I2C master API. An installed bus with no devices gets the default
+ * board: BME280 at 0x76, BMP280 at 0x77 and ADXL345 at 0x53.
+ * Unless real time is enabled, bus time advances a virtual clock that is
+ * added to the host clock returned by esp_timer_get_time().
+ * An ADXL345 model can also sit on a SPI host behind the SPI master API,
+ * per-device calls then take I2CSIM_SPI_PORT(host) and the CS pin.
+ */
+
+#ifndef I2CSIM_H_
+#define I2CSIM_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "driver/i2c.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "esp_rom_sys.h"
+
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    I2CSIM_MAX_DEVICES        8
+#define    I2CSIM_ADXL_FIFO_DEPTH    32
+#define    I2CSIM_SPI_QUEUE_MAX      64    /* Queued transactions per SPI device */
+#define    I2CSIM_SPI_PORT(host)     ((i2c_port_t)(I2C_NUM_MAX + (host)))  /* Device lookup port of a SPI host */
+
+
+/******************************************************************************
+ *** ENUMS
+ ******************************************************************************/
+
+/** @enum I2CSIM_part_e
+*   @brief Simulated part number
+*/
+typedef enum{
+    I2CSIM_BME280,
+    I2CSIM_BMP280,
+    I2CSIM_ADXL345
+}I2CSIM_part_e;
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** \brief  ADXL345 acceleration source, called once per output data sample
+ * \param arg User argument
+ * \param index Sample counter since the source was attached
+ * \param mg Acceleration of x, y, z in milli-g
+ */
+typedef void (*I2CSIM_adxlSource_t)(void *arg, uint32_t index, int32_t mg[3]);
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Remove every simulated device and clear bus settings
+ * \param[] Nothing
+ * \return  Nothing
+ */
+void I2CSIM_Reset(void);
+
+/** \brief  Attach a device model to a simulated bus
+ * \param port Bus number
+ * \param addr 7 bit slave address
+ * \param part Device model
+ * \return  ESP_OK or ESP_ERR_NO_MEM when every slot is used
+ */
+esp_err_t I2CSIM_AddDevice(i2c_port_t port, uint8_t addr, I2CSIM_part_e part);
+
+/** \brief  Attach a device model to a simulated SPI host, it answers when its
+ *          CS pin is driven in SPI mode 3 at no more than 5 MHz
+ * \param host SPI host
+ * \param csIo CS pin
+ * \param part Device model, only I2CSIM_ADXL345 speaks SPI
+ * \return  ESP_OK, ESP_ERR_INVALID_ARG or ESP_ERR_NO_MEM when every slot is used
+ */
+esp_err_t I2CSIM_AddSpiDevice(spi_host_device_t host, int csIo, I2CSIM_part_e part);
+
+/** \brief  Accumulated SCLK time of a SPI host
+ * \param host SPI host
+ * \return  Bus time (ns)
+ */
+uint64_t I2CSIM_SpiBusTimeNs(spi_host_device_t host);
+
+/** \brief  Fixed latency added to every transaction of a bus
+ * \param port Bus number
+ * \param latencyUs Latency (us)
+ * \return  Nothing
+ */
+void I2CSIM_SetLatency(i2c_port_t port, uint32_t latencyUs);
+
+/** \brief  Sleep for the simulated bus time instead of only accounting it
+ * \param enable Real time operation
+ * \return  Nothing
+ */
+void I2CSIM_SetRealTime(bool enable);
+
+/** \brief  Clock stretching added by a device on each transaction
+ * \param port Bus number
+ * \param addr Slave address
+ * \param stretchUs Stretch time (us), beyond the transaction timeout gives ESP_ERR_TIMEOUT
+ * \return  ESP_OK or ESP_ERR_NOT_FOUND
+ */
+esp_err_t I2CSIM_SetClockStretch(i2c_port_t port, uint8_t addr, uint32_t stretchUs);
+
+/** \brief  NACK the address phase of the next transactions to a device
+ * \param port Bus number
+ * \param addr Slave address
+ * \param count Number of transactions to NACK
+ * \return  ESP_OK or ESP_ERR_NOT_FOUND
+ */
+esp_err_t I2CSIM_InjectNack(i2c_port_t port, uint8_t addr, uint32_t count);
+
+/** \brief  Highest SCL frequency a device answers at, models a marginal cable
+ * \param port Bus number
+ * \param addr Slave address
+ * \param clkSpeed Frequency (Hz), the address is NACKed above it, 0 for no limit
+ * \return  ESP_OK or ESP_ERR_NOT_FOUND
+ */
+esp_err_t I2CSIM_SetMaxClock(i2c_port_t port, uint8_t addr, uint32_t clkSpeed);
+
+/** \brief  A slave holds SDA low, every transaction of the bus times out until
+ *          the given number of SCL pulses is clocked by a bus clear
+ * \param port Bus number
+ * \param clocks SCL pulses until SDA is released, 0 releases at once
+ * \return  ESP_OK or ESP_ERR_INVALID_ARG
+ */
+esp_err_t I2CSIM_StickSda(i2c_port_t port, uint32_t clocks);
+
+/** \brief  Wire the INT1 and INT2 outputs of an ADXL345 model to GPIOs
+ * \param port Bus number
+ * \param addr Slave address
+ * \param int1Gpio INT1 pin, -1 when not wired
+ * \param int2Gpio INT2 pin, -1 when not wired
+ * \return  ESP_OK or ESP_ERR_NOT_FOUND
+ */
+esp_err_t I2CSIM_SetAdxlIntPins(i2c_port_t port, uint8_t addr, int int1Gpio, int int2Gpio);
+
+/** \brief  Advance the ADXL345 models to the current time and run the GPIO ISR
+ *          of every interrupt output that was asserted since the last call
+ * \param[] Nothing
+ * \return  Number of ISRs run
+ */
+int I2CSIM_ServiceInterrupts(void);
+
+/** \brief  Uncompensated values produced by the next BMx280 conversions
+ * \param port Bus number
+ * \param addr Slave address
+ * \param press 20 bit raw pressure
+ * \param temp 20 bit raw temperature
+ * \param hum 16 bit raw humidity, ignored by the BMP280
+ * \return  ESP_OK or ESP_ERR_NOT_FOUND
+ */
+esp_err_t I2CSIM_SetBmx280Raw(i2c_port_t port, uint8_t addr, int32_t press, int32_t temp, int32_t hum);
+
+/** \brief  Attach the acceleration source of an ADXL345 model
+ * \param port Bus number
+ * \param addr Slave address
+ * \param source Source callback, NULL restores the 1 g on Z default
+ * \param arg User argument
+ * \return  ESP_OK or ESP_ERR_NOT_FOUND
+ */
+esp_err_t I2CSIM_SetAdxlSource(i2c_port_t port, uint8_t addr, I2CSIM_adxlSource_t source, void *arg);
+
+/** \brief  Read a model register without a bus transaction
+ * \param port Bus number
+ * \param addr Slave address
+ * \param reg Register address
+ * \param data Register value
+ * \return  ESP_OK or ESP_ERR_NOT_FOUND
+ */
+esp_err_t I2CSIM_PeekReg(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t *data);
+
+/** \brief  Accumulated SCL time of a bus including latency and stretching
+ * \param port Bus number
+ * \return  Bus time (ns)
+ */
+uint64_t I2CSIM_BusTimeNs(i2c_port_t port);
+
+#endif /* I2CSIM_H_ */
@@ -0,0 +1,306 @@
+/**
+ * \file spectrum.c
+ * \author Ugurcan OZTURK
+ * \brief	Fixed-Point Vibration Spectrum Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "spectrum.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    SPECTRUM_QUARTER          (SPECTRUM_SIZE_MAX / 4)
+#define    SPECTRUM_Q15_ONE          32767
+#define    SPECTRUM_INPUT_MAX        16383 /* FFT input headroom, |x| < 2^14 */
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static const SPECTRUM_config_t *spectrumConf;
+static int16_t sinTable[SPECTRUM_QUARTER + 1];          /* sin(2 pi k / SIZE_MAX), first quadrant */
+static int16_t hannWindow[SPECTRUM_SIZE_MAX];
+static int16_t fftWork[2 * SPECTRUM_SIZE_MAX];
+static int16_t blockSamples[SPECTRUM_SIZE_MAX * SPECTRUM_AXES];
+static uint16_t blockFill;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Twiddle factor from the quarter-wave table
+ * \param j Angle index on the SPECTRUM_SIZE_MAX circle, 0..SIZE_MAX/2-1
+ * \param wr cos(2 pi j / SIZE_MAX), Q15
+ * \param wi -sin(2 pi j / SIZE_MAX), Q15
+ * \return Nothing
+ */
+static void SPECTRUM_Twiddle(uint32_t j, int32_t *wr, int32_t *wi);
+
+/** \brief  Integer square root
+ * \param value Radicand
+ * \return floor(sqrt(value))
+ */
+static uint32_t SPECTRUM_Isqrt(uint64_t value);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static void SPECTRUM_Twiddle(uint32_t j, int32_t *wr, int32_t *wi){
+
+     if(j <= SPECTRUM_QUARTER){
+          *wr =  sinTable[SPECTRUM_QUARTER - j];
+          *wi = -sinTable[j];
+     }else
+     {
+          *wr = -sinTable[j - SPECTRUM_QUARTER];
+          *wi = -sinTable[2 * SPECTRUM_QUARTER - j];
+     }
+}
+
+static uint32_t SPECTRUM_Isqrt(uint64_t value){
+
+     uint64_t root = 0;
+     uint64_t bit  = 1ULL << 62;
+
+     while(bit > value){
+          bit >>= 2;
+     }
+     while(bit != 0){
+          if(value >= root + bit){
+               value -= root + bit;
+               root   = (root >> 1) + bit;
+          }else
+          {
+               root >>= 1;
+          }
+          bit >>= 2;
+     }
+     return (uint32_t)root;
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+esp_err_t SPECTRUM_Init(const SPECTRUM_config_t *config){
+
+     uint16_t size = config->size;
+
+     if((size != SPECTRUM_SIZE_256 && size != SPECTRUM_SIZE_512 && size != SPECTRUM_SIZE_1024) ||
+        size > SPECTRUM_SIZE_MAX || config->sampleRateHz_u16 == 0 ||
+        config->bandCount_u8 == 0 || config->bandCount_u8 > SPECTRUM_BANDS_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+     for(uint8_t b = 0; b < config->bandCount_u8; b++){
+          if(config->bandEdgesHz_u16[b] >= config->bandEdgesHz_u16[b + 1]){
+               return ESP_ERR_INVALID_ARG;
+          }
+     }
+
+     /* Tables are built once in float, the per-block path is integer only */
+     for(uint32_t k = 0; k <= SPECTRUM_QUARTER; k++){
+          sinTable[k] = (int16_t)lrintf(SPECTRUM_Q15_ONE * sinf(2.0f * (float)M_PI * k / SPECTRUM_SIZE_MAX));
+     }
+     for(uint32_t n = 0; n < size; n++){
+          float s = sinf((float)M_PI * n / size);
+
+          hannWindow[n] = (int16_t)lrintf(SPECTRUM_Q15_ONE * s * s);
+     }
+
+     spectrumConf = config;
+     blockFill = 0;
+
+     return ESP_OK;
+}
+
+void SPECTRUM_Reset(void){
+
+     blockFill = 0;
+}
+
+size_t SPECTRUM_Feed(const int16_t *xyz, size_t count){
+
+     size_t room = spectrumConf->size - blockFill;
+
+     if(count > room){
+          count = room;
+     }
+     memcpy(&blockSamples[blockFill * SPECTRUM_AXES], xyz, count * SPECTRUM_AXES * sizeof(int16_t));
+     blockFill += count;
+
+     return count;
+}
+
+bool SPECTRUM_Ready(void){
+
+     return spectrumConf != NULL && blockFill == spectrumConf->size;
+}
+
+esp_err_t SPECTRUM_Process(SPECTRUM_features_t *features){
+
+     if(!SPECTRUM_Ready()){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     for(size_t axis = 0; axis < SPECTRUM_AXES; axis++){
+          SPECTRUM_Analyze(&blockSamples[axis], SPECTRUM_AXES, &features[axis]);
+     }
+     blockFill = 0;
+
+     return ESP_OK;
+}
+
+void SPECTRUM_Analyze(const int16_t *samples, size_t stride, SPECTRUM_features_t *features){
+
+     uint16_t size = spectrumConf->size;
+     uint64_t bandSum[SPECTRUM_BANDS_MAX] = { 0 };
+     uint32_t peakPower = 0;
+     uint16_t peakBin = 0;
+     int32_t  sum = 0;
+     int32_t  mean;
+     int32_t  maxAbs = 0;
+     int32_t  exponent = 0;   /* Block scale 2^exponent, negative above the headroom */
+     int32_t  energyShift;
+     uint32_t amp;
+     uint8_t  band = 0;
+
+     memset(features, 0, sizeof(*features));
+
+     for(uint16_t n = 0; n < size; n++){
+          sum += samples[n * stride];
+     }
+     mean = sum / size;
+
+     for(uint16_t n = 0; n < size; n++){
+          int32_t v = samples[n * stride] - mean;
+
+          if(v < 0){
+               v = -v;
+          }
+          if(v > maxAbs){
+               maxAbs = v;
+          }
+     }
+     if(maxAbs == 0){
+          return;
+     }
+
+     /* Block floating point: scale the block up to the 2^14 headroom so small
+        vibrations keep their resolution through the 1/2 per stage scaling,
+        and down when a deviation exceeds it. Scaled by multiplication, a
+        left shift of a negative deviation is undefined */
+     while((maxAbs >> -exponent) > SPECTRUM_INPUT_MAX){
+          exponent--;
+     }
+     while(exponent >= 0 && (maxAbs << (exponent + 1)) <= SPECTRUM_INPUT_MAX){
+          exponent++;
+     }
+     for(uint16_t n = 0; n < size; n++){
+          int32_t v = samples[n * stride] - mean;
+
+          v = (exponent >= 0) ? v * (1 << exponent) : v / (1 << -exponent);
+          fftWork[2 * n]     = (int16_t)((v * hannWindow[n]) >> 15);
+          fftWork[2 * n + 1] = 0;
+     }
+
+     SPECTRUM_Fft(fftWork, size);
+
+     /* Bins 1..size/2-1, DC is removed and Nyquist has no band */
+     for(uint16_t k = 1; k < size / 2; k++){
+          int32_t  re = fftWork[2 * k];
+          int32_t  im = fftWork[2 * k + 1];
+          uint32_t power = (uint32_t)(re * re) + (uint32_t)(im * im);
+          uint32_t freqScaled = (uint32_t)k * spectrumConf->sampleRateHz_u16;   /* Hz times size */
+
+          if(power > peakPower){
+               peakPower = power;
+               peakBin   = k;
+          }
+          while(band < spectrumConf->bandCount_u8 &&
+                freqScaled >= (uint32_t)spectrumConf->bandEdgesHz_u16[band + 1] * size){
+               band++;
+          }
+          if(band < spectrumConf->bandCount_u8 &&
+             freqScaled >= (uint32_t)spectrumConf->bandEdgesHz_u16[band] * size){
+               bandSum[band] += power;
+          }
+     }
+
+     /* Power carries the block scale squared */
+     energyShift = SPECTRUM_ENERGY_FRAC_BITS - 2 * exponent;
+     for(uint8_t b = 0; b < spectrumConf->bandCount_u8; b++){
+          uint64_t energy = (energyShift < 0) ? bandSum[b] >> -energyShift : bandSum[b] << energyShift;
+
+          features->bandEnergy_u32[b] = (energy > UINT32_MAX) ? UINT32_MAX : (uint32_t)energy;
+     }
+
+     /* Hann coherent gain 1/2 and the one-sided spectrum give amplitude = 4 |X[k]| */
+     features->peakDeciHz_u16 = (uint16_t)(((uint32_t)peakBin * spectrumConf->sampleRateHz_u16 * 10) / size);
+     amp = 4 * SPECTRUM_Isqrt(peakPower);
+     amp = (exponent >= 0) ? amp >> exponent : amp << -exponent;
+     features->peakAmp_u16    = (amp > UINT16_MAX) ? UINT16_MAX : (uint16_t)amp;
+}
+
+void SPECTRUM_Fft(int16_t *data, uint16_t size){
+
+     uint16_t j = 0;
+
+     /* Bit-reversed order, then decimation in time */
+     for(uint16_t i = 1; i < size; i++){
+          uint16_t bit = size >> 1;
+
+          while(j & bit){
+               j  ^= bit;
+               bit >>= 1;
+          }
+          j |= bit;
+
+          if(i < j){
+               int16_t re = data[2 * i];
+               int16_t im = data[2 * i + 1];
+
+               data[2 * i]     = data[2 * j];
+               data[2 * i + 1] = data[2 * j + 1];
+               data[2 * j]     = re;
+               data[2 * j + 1] = im;
+          }
+     }
+
+     for(uint16_t len = 2; len <= size; len <<= 1){
+          uint16_t half = len >> 1;
+          uint32_t step = SPECTRUM_SIZE_MAX / len;
+
+          for(uint16_t k = 0; k < half; k++){
+               int32_t wr;
+               int32_t wi;
+
+               SPECTRUM_Twiddle(k * step, &wr, &wi);
+
+               for(uint16_t a = k; a < size; a += len){
+                    uint16_t b  = a + half;
+                    int32_t  br = data[2 * b];
+                    int32_t  bi = data[2 * b + 1];
+                    int32_t  tr = (br * wr - bi * wi + (1 << 14)) >> 15;
+                    int32_t  ti = (br * wi + bi * wr + (1 << 14)) >> 15;
+                    int32_t  ar = data[2 * a];
+                    int32_t  ai = data[2 * a + 1];
+
+                    data[2 * a]     = (int16_t)((ar + tr) >> 1);
+                    data[2 * a + 1] = (int16_t)((ai + ti) >> 1);
+                    data[2 * b]     = (int16_t)((ar - tr) >> 1);
+                    data[2 * b + 1] = (int16_t)((ai - ti) >> 1);
+               }
+          }
+     }
+}
@@ -0,0 +1,179 @@
+/**
+ * \file vibfeat.c
+ * \author Ugurcan OZTURK
+ * \brief	Time-Domain Vibration Features Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "vibfeat.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    VIBFEAT_DEV_MAX           8191  /* |x - offset| bound, 13 bit ADXL345 output */
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Add one sample to the power sums of an axis
+ * \param acc Axis accumulator
+ * \param first First sample of the window
+ * \param x Sample
+ * \return Nothing
+ */
+static void VIBFEAT_Accumulate(VIBFEAT_accum_t *acc, bool first, int16_t x);
+
+/** \brief  Features of one axis from its power sums
+ * \param acc Axis accumulator
+ * \param n Samples in the window
+ * \param features Axis result
+ * \return Nothing
+ */
+static void VIBFEAT_Finish(const VIBFEAT_accum_t *acc, uint16_t n, VIBFEAT_features_t *features);
+
+/** \brief  Saturate to uint16_t
+ * \param value Value
+ * \return Rounded value clamped to 0..UINT16_MAX
+ */
+static uint16_t VIBFEAT_SatU16(double value);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static void VIBFEAT_Accumulate(VIBFEAT_accum_t *acc, bool first, int16_t x){
+
+     int32_t d;
+     int64_t d2;
+
+     if(first){
+          memset(acc, 0, sizeof(*acc));
+          acc->offset_s16 = x;
+          acc->min_s16    = x;
+          acc->max_s16    = x;
+     }
+     if(x < acc->min_s16){
+          acc->min_s16 = x;
+     }
+     if(x > acc->max_s16){
+          acc->max_s16 = x;
+     }
+
+     d = (int32_t)x - acc->offset_s16;
+     if(d > VIBFEAT_DEV_MAX){
+          d = VIBFEAT_DEV_MAX;
+     }else if(d < -VIBFEAT_DEV_MAX){
+          d = -VIBFEAT_DEV_MAX;
+     }
+     d2 = (int64_t)d * d;
+
+     acc->sum1_s64 += d;
+     acc->sum2_u64 += (uint64_t)d2;
+     acc->sum3_s64 += d2 * d;
+     acc->sum4_u64 += (uint64_t)(d2 * d2);
+}
+
+static void VIBFEAT_Finish(const VIBFEAT_accum_t *acc, uint16_t n, VIBFEAT_features_t *features){
+
+     /* Central moments from the exact integer sums, once per window */
+     double mu = (double)acc->sum1_s64 / n;
+     double e2 = (double)acc->sum2_u64 / n;
+     double e3 = (double)acc->sum3_s64 / n;
+     double e4 = (double)acc->sum4_u64 / n;
+     double m2 = e2 - mu * mu;
+     double m4 = e4 - 4.0 * mu * e3 + 6.0 * mu * mu * e2 - 3.0 * mu * mu * mu * mu;
+     double mean = acc->offset_s16 + mu;
+     double rms;
+     double peak;
+
+     if(m2 < 0.0){
+          m2 = 0.0;
+     }
+     rms  = sqrt(m2);
+     peak = fmax(acc->max_s16 - mean, mean - acc->min_s16);
+
+     features->mean_s16       = (int16_t)lrint(mean);
+     features->rms_u16        = VIBFEAT_SatU16(rms);
+     features->peakToPeak_u16 = (uint16_t)(acc->max_s16 - acc->min_s16);
+     features->crestQ8_u16    = (rms > 0.0) ? VIBFEAT_SatU16(peak * VIBFEAT_Q8_ONE / rms) : 0;
+     features->kurtosisQ8_u16 = (m2 > 0.0) ? VIBFEAT_SatU16(m4 * VIBFEAT_Q8_ONE / (m2 * m2)) : 0;
+}
+
+static uint16_t VIBFEAT_SatU16(double value){
+
+     if(value <= 0.0){
+          return 0;
+     }
+     if(value >= UINT16_MAX){
+          return UINT16_MAX;
+     }
+     return (uint16_t)lrint(value);
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+esp_err_t VIBFEAT_Init(VIBFEAT_window_t *win, uint16_t window){
+
+     if(window < 2 || window > VIBFEAT_WINDOW_MAX){
+          return ESP_ERR_INVALID_ARG;
+     }
+
+     win->window_u16 = window;
+     win->count_u16  = 0;
+
+     return ESP_OK;
+}
+
+void VIBFEAT_Reset(VIBFEAT_window_t *win){
+
+     win->count_u16 = 0;
+}
+
+size_t VIBFEAT_Feed(VIBFEAT_window_t *win, const int16_t *xyz, size_t count){
+
+     size_t room = win->window_u16 - win->count_u16;
+
+     if(count > room){
+          count = room;
+     }
+     for(size_t i = 0; i < count; i++){
+          for(size_t axis = 0; axis < VIBFEAT_AXES; axis++){
+               VIBFEAT_Accumulate(&win->axis[axis], win->count_u16 == 0, xyz[i * VIBFEAT_AXES + axis]);
+          }
+          win->count_u16++;
+     }
+
+     return count;
+}
+
+bool VIBFEAT_Ready(const VIBFEAT_window_t *win){
+
+     return win->window_u16 != 0 && win->count_u16 == win->window_u16;
+}
+
+esp_err_t VIBFEAT_Process(VIBFEAT_window_t *win, VIBFEAT_features_t *features){
+
+     if(!VIBFEAT_Ready(win)){
+          return ESP_ERR_INVALID_STATE;
+     }
+
+     for(size_t axis = 0; axis < VIBFEAT_AXES; axis++){
+          VIBFEAT_Finish(&win->axis[axis], win->count_u16, &features[axis]);
+     }
+     win->count_u16 = 0;
+
+     return ESP_OK;
+}
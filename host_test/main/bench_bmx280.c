@@ -0,0 +1,322 @@
+/**
+ * \file bench_bmx280.c
+ * \author Ugurcan OZTURK
+ * \brief	BMX280 Compensation Benchmark Source File
+ * \date 17.10.2026
+ *
+ * Integer compensation against the Bosch datasheet floating point formulas
+ * over a sweep of raw values: worst error and host time per sample of the
+ * driver functions, the inline kernels, the batch and the specialized
+ * variants.
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "i2csim.h"
+#include "i2cbus.h"
+#include "bmx280.h"
+#include "bmx280comp.h"
+#include "hosttest.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    BENCH_PORT                I2C_NUM_0
+#define    BENCH_ADDR                0x76
+#define    BENCH_SAMPLES             50000
+#define    BENCH_PASSES              2     /* The first pass warms the caches */
+#define    BENCH_PRESS64_MAX_PA      1.0   /* Q24.8 result */
+#define    BENCH_PRESS32_MAX_PA      10.0  /* Whole Pa result */
+#define    BENCH_TEMP_MAX_C          0.01
+#define    BENCH_HUM_MAX_RH          0.01
+
+/* Time one loop over the sweep and print it per sample */
+#define    BENCH_TIME(label, ...)                                                                        \
+     do{                                                                                                 \
+          uint64_t benchStartNs = HOSTTEST_NowNs();                                                      \
+          __VA_ARGS__;                                                                                   \
+          printf("  %-24s %6.1f ns/sample\n", (label), (double)(HOSTTEST_NowNs() - benchStartNs) / BENCH_SAMPLES); \
+     }while(0)
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static I2CBUS_device_t benchDev = { .port = BENCH_PORT, .addr = BENCH_ADDR, .clkSpeed = 400000, .timeoutMs = 20 };
+static BMX280_t benchCtx;
+static BME280_rawData_t raw[BENCH_SAMPLES];
+static double refTemp[BENCH_SAMPLES];
+static double refPress[BENCH_SAMPLES];
+static double refHum[BENCH_SAMPLES];
+static BME280_data_t out[BENCH_SAMPLES];
+static BME280_data_t outCheck[BENCH_SAMPLES];
+static uint32_t press32[BENCH_SAMPLES];   /* Whole Pa results of the 32 bit kernel */
+static volatile uint32_t benchSink;   /* Keeps timed results alive */
+
+/* Datasheet example trimming, the one the simulated BME280 carries */
+BMX280COMP_SPECIALIZE(benchSpec, true, {
+     .dig_T1 = 27504, .dig_T2 = 26435, .dig_T3 = -1000,
+     .dig_P1 = 36477, .dig_P2 = -10685, .dig_P3 = 3024, .dig_P4 = 2855, .dig_P5 = 140,
+     .dig_P6 = -7, .dig_P7 = 15500, .dig_P8 = -14600, .dig_P9 = 6000,
+     .dig_H1 = 75, .dig_H2 = 370, .dig_H3 = 0, .dig_H4 = 308, .dig_H5 = 50, .dig_H6 = 30 })
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Datasheet floating point temperature compensation
+ * \param calib Trimming parameters
+ * \param adc_T Raw temperature
+ * \param tFine Fine temperature for the pressure and humidity formulas
+ * \return Temperature in DegC
+ */
+static double HOSTTEST_RefTemp(const BME280_calibData_t *calib, int32_t adc_T, double *tFine);
+
+/** \brief  Datasheet floating point pressure compensation
+ * \param calib Trimming parameters
+ * \param adc_P Raw pressure
+ * \param tFine Fine temperature of the same snapshot
+ * \return Pressure in Pa
+ */
+static double HOSTTEST_RefPress(const BME280_calibData_t *calib, int32_t adc_P, double tFine);
+
+/** \brief  Datasheet floating point humidity compensation
+ * \param calib Trimming parameters
+ * \param adc_H Raw humidity
+ * \param tFine Fine temperature of the same snapshot
+ * \return Humidity in %RH
+ */
+static double HOSTTEST_RefHum(const BME280_calibData_t *calib, int32_t adc_H, double tFine);
+
+/** \brief  Worst error of compensated snapshots against the double reference
+ * \param name Variant name
+ * \param data Compensated sweep
+ * \return Nothing
+ */
+static void HOSTTEST_BenchErrors(const char *name, const BME280_data_t *data);
+
+/** \brief  Calibration from the simulated part and the raw value sweep with its reference results
+ * \param[] Nothing
+ * \return Bus status of the calibration read
+ */
+static esp_err_t HOSTTEST_BenchSetup(void);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static double HOSTTEST_RefTemp(const BME280_calibData_t *calib, int32_t adc_T, double *tFine){
+
+     double var1, var2;
+
+     var1 = ((double)adc_T / 16384.0 - (double)calib->dig_T1 / 1024.0) * (double)calib->dig_T2;
+     var2 = ((double)adc_T / 131072.0 - (double)calib->dig_T1 / 8192.0) *
+            ((double)adc_T / 131072.0 - (double)calib->dig_T1 / 8192.0) * (double)calib->dig_T3;
+     *tFine = var1 + var2;
+
+     return (var1 + var2) / 5120.0;
+}
+
+static double HOSTTEST_RefPress(const BME280_calibData_t *calib, int32_t adc_P, double tFine){
+
+     double var1, var2, p;
+
+     var1 = tFine / 2.0 - 64000.0;
+     var2 = var1 * var1 * (double)calib->dig_P6 / 32768.0;
+     var2 = var2 + var1 * (double)calib->dig_P5 * 2.0;
+     var2 = var2 / 4.0 + (double)calib->dig_P4 * 65536.0;
+     var1 = ((double)calib->dig_P3 * var1 * var1 / 524288.0 + (double)calib->dig_P2 * var1) / 524288.0;
+     var1 = (1.0 + var1 / 32768.0) * (double)calib->dig_P1;
+     if(var1 == 0.0){
+          return 0.0;
+     }
+     p = 1048576.0 - (double)adc_P;
+     p = (p - var2 / 4096.0) * 6250.0 / var1;
+     var1 = (double)calib->dig_P9 * p * p / 2147483648.0;
+     var2 = p * (double)calib->dig_P8 / 32768.0;
+
+     return p + (var1 + var2 + (double)calib->dig_P7) / 16.0;
+}
+
+static double HOSTTEST_RefHum(const BME280_calibData_t *calib, int32_t adc_H, double tFine){
+
+     double h = tFine - 76800.0;
+
+     h = (adc_H - ((double)calib->dig_H4 * 64.0 + (double)calib->dig_H5 / 16384.0 * h)) *
+         ((double)calib->dig_H2 / 65536.0 * (1.0 + (double)calib->dig_H6 / 67108864.0 * h *
+         (1.0 + (double)calib->dig_H3 / 67108864.0 * h)));
+     h = h * (1.0 - (double)calib->dig_H1 * h / 524288.0);
+
+     return (h > 100.0) ? 100.0 : (h < 0.0) ? 0.0 : h;
+}
+
+static void HOSTTEST_BenchErrors(const char *name, const BME280_data_t *data){
+
+     double errTemp = 0.0, errPress = 0.0, errHum = 0.0, err;
+
+     for(int i = 0; i < BENCH_SAMPLES; i++){
+          err = fabs(data[i].temp_s32 / 100.0 - refTemp[i]);
+          errTemp = (err > errTemp) ? err : errTemp;
+          err = fabs(data[i].press_u32 / 256.0 - refPress[i]);
+          errPress = (err > errPress) ? err : errPress;
+          /* The clamped ends differ by design */
+          if(refHum[i] > 0.0 && refHum[i] < 100.0){
+               err = fabs(data[i].hum_u32 / 1024.0 - refHum[i]);
+               errHum = (err > errHum) ? err : errHum;
+          }
+     }
+     printf("  %-24s max error T %.4f C, P %.3f Pa, H %.4f %%RH\n", name, errTemp, errPress, errHum);
+     HOSTTEST_CHECK(errTemp <= BENCH_TEMP_MAX_C);
+     HOSTTEST_CHECK(errPress <= BENCH_PRESS64_MAX_PA);
+     HOSTTEST_CHECK(errHum <= BENCH_HUM_MAX_RH);
+}
+
+static esp_err_t HOSTTEST_BenchSetup(void){
+
+     I2CBUS_busConfig_t busConf = { .port = BENCH_PORT, .sdaIo = 21, .sclIo = 22, .clkSpeed = 400000 };
+     BMX280_config_t config = { .mode = BME280_SLEEP_MODE, .tempOver = TEMP_OVERSAMPLING_X2,
+                                .pressOver = PRESS_OVERSAMPLING_X16, .humOver = HUM_OVERSAMPLING_X1 };
+     esp_err_t status;
+     double tFine;
+
+     I2CSIM_Reset();
+     I2CSIM_AddDevice(BENCH_PORT, BENCH_ADDR, I2CSIM_BME280);
+     I2CBUS_Init(&busConf);
+     status = BMX280_Init(&benchCtx, &benchDev, &config);
+
+     /* Spread over the raw ranges, skipped-channel codes excluded */
+     for(int32_t i = 0; i < BENCH_SAMPLES; i++){
+          raw[i].temp_s32  = 400000 + (int32_t)((i * 7919LL) % 250000);
+          raw[i].press_s32 = 250000 + (int32_t)((i * 104729LL) % 300000);
+          raw[i].hum_s32   = 20000 + (i * 31) % 30000;
+          if(raw[i].press_s32 == BME280_PRESS_SKIPPED){
+               raw[i].press_s32++;
+          }
+          if(raw[i].hum_s32 == BME280_HUM_SKIPPED){
+               raw[i].hum_s32++;
+          }
+          refTemp[i]  = HOSTTEST_RefTemp(&benchCtx.calib, raw[i].temp_s32, &tFine);
+          refPress[i] = HOSTTEST_RefPress(&benchCtx.calib, raw[i].press_s32, tFine);
+          refHum[i]   = HOSTTEST_RefHum(&benchCtx.calib, raw[i].hum_s32, tFine);
+     }
+
+     return status;
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+void HOSTTEST_BenchPressure(void){
+
+     double errTemp = 0.0, err64 = 0.0, err32 = 0.0, err;
+     double tFine;
+
+     printf("bmx280 pressure: 64 bit, 32 bit and datasheet double\n");
+
+     HOSTTEST_CHECK(HOSTTEST_BenchSetup() == ESP_OK);
+
+     for(int i = 0; i < BENCH_SAMPLES; i++){
+          err = fabs(BMX280_CompensateTemp(&benchCtx, raw[i].temp_s32) / 100.0 - refTemp[i]);
+          errTemp = (err > errTemp) ? err : errTemp;
+          err = fabs(BMX280_CompensatePress64(&benchCtx, raw[i].press_s32) / 256.0 - refPress[i]);
+          err64 = (err > err64) ? err : err64;
+          err = fabs(BMX280_CompensatePress32(&benchCtx, raw[i].press_s32) - refPress[i]);
+          err32 = (err > err32) ? err : err32;
+     }
+     printf("  max error vs double: T %.4f C, P64 %.3f Pa, P32 %.3f Pa\n", errTemp, err64, err32);
+     HOSTTEST_CHECK(errTemp <= 0.01);
+     HOSTTEST_CHECK(err64 <= BENCH_PRESS64_MAX_PA);
+     HOSTTEST_CHECK(err32 <= BENCH_PRESS32_MAX_PA);
+
+     for(int pass = 0; pass < BENCH_PASSES; pass++){
+          BENCH_TIME("T+P 64 bit", for(int i = 0; i < BENCH_SAMPLES; i++){
+               BMX280_CompensateTemp(&benchCtx, raw[i].temp_s32);
+               benchSink += BMX280_CompensatePress64(&benchCtx, raw[i].press_s32);
+          });
+          BENCH_TIME("T+P 32 bit", for(int i = 0; i < BENCH_SAMPLES; i++){
+               BMX280_CompensateTemp(&benchCtx, raw[i].temp_s32);
+               benchSink += BMX280_CompensatePress32(&benchCtx, raw[i].press_s32);
+          });
+          BENCH_TIME("T+P double", for(int i = 0; i < BENCH_SAMPLES; i++){
+               HOSTTEST_RefTemp(&benchCtx.calib, raw[i].temp_s32, &tFine);
+               benchSink += (uint32_t)HOSTTEST_RefPress(&benchCtx.calib, raw[i].press_s32, tFine);
+          });
+     }
+}
+
+void HOSTTEST_BenchCompensation(void){
+
+     const BME280_calibData_t *calib = &benchCtx.calib;
+     bool same = true;
+     double tFine, errPress32;
+     int32_t tf;
+
+     printf("bmx280 compensation variants\n");
+
+     HOSTTEST_CHECK(HOSTTEST_BenchSetup() == ESP_OK);
+     HOSTTEST_CHECK(memcmp(calib, &benchSpec_calib, sizeof(*calib)) == 0);
+
+     for(int pass = 0; pass < BENCH_PASSES; pass++){
+          BENCH_TIME("kernel T", for(int i = 0; i < BENCH_SAMPLES; i++){
+               out[i].temp_s32 = BMX280COMP_Temp(BMX280COMP_TFine(calib, raw[i].temp_s32));
+          });
+          BENCH_TIME("kernel T+P64", for(int i = 0; i < BENCH_SAMPLES; i++){
+               tf = BMX280COMP_TFine(calib, raw[i].temp_s32);
+               out[i].press_u32 = BMX280COMP_Press64(calib, tf, raw[i].press_s32);
+          });
+          BENCH_TIME("kernel T+P32", for(int i = 0; i < BENCH_SAMPLES; i++){
+               tf = BMX280COMP_TFine(calib, raw[i].temp_s32);
+               press32[i] = BMX280COMP_Press32(calib, tf, raw[i].press_s32);
+          });
+          BENCH_TIME("kernel T+H", for(int i = 0; i < BENCH_SAMPLES; i++){
+               tf = BMX280COMP_TFine(calib, raw[i].temp_s32);
+               out[i].hum_u32 = BMX280COMP_Hum(calib, tf, raw[i].hum_s32);
+          });
+          BENCH_TIME("BMX280_Compensate", for(int i = 0; i < BENCH_SAMPLES; i++){
+               BMX280_Compensate(&benchCtx, &raw[i], &outCheck[i]);
+          });
+          BENCH_TIME("BMX280_CompensateBatch", benchSink += BMX280_CompensateBatch(&benchCtx, raw, outCheck, BENCH_SAMPLES));
+          BENCH_TIME("specialized single", for(int i = 0; i < BENCH_SAMPLES; i++){
+               benchSpec_Compensate(&raw[i], &outCheck[i]);
+          });
+          BENCH_TIME("specialized batch", benchSink += benchSpec_Batch(raw, outCheck, BENCH_SAMPLES));
+          BENCH_TIME("double T+P+H", for(int i = 0; i < BENCH_SAMPLES; i++){
+               HOSTTEST_RefTemp(calib, raw[i].temp_s32, &tFine);
+               benchSink += (uint32_t)HOSTTEST_RefPress(calib, raw[i].press_s32, tFine) + (uint32_t)HOSTTEST_RefHum(calib, raw[i].hum_s32, tFine);
+          });
+     }
+
+     /* Kernels with the 64 bit pressure, then the whole Pa 32 bit pressure */
+     HOSTTEST_BenchErrors("kernels T/P64/H", out);
+     errPress32 = 0.0;
+     for(int i = 0; i < BENCH_SAMPLES; i++){
+          double err = fabs(press32[i] - refPress[i]);
+          errPress32 = (err > errPress32) ? err : errPress32;
+     }
+     printf("  %-24s max error P %.3f Pa\n", "kernel P32", errPress32);
+     HOSTTEST_CHECK(errPress32 <= BENCH_PRESS32_MAX_PA);
+
+     BMX280_CompensateBatch(&benchCtx, raw, out, BENCH_SAMPLES);
+     HOSTTEST_BenchErrors("BMX280_CompensateBatch", out);
+     benchSpec_Batch(raw, outCheck, BENCH_SAMPLES);
+     HOSTTEST_BenchErrors("specialized batch", outCheck);
+
+     /* Every variant computes the same integer results */
+     for(int i = 0; i < BENCH_SAMPLES && same; i++){
+          BME280_data_t single;
+          same = (memcmp(&out[i], &outCheck[i], sizeof(single)) == 0);
+          BMX280_Compensate(&benchCtx, &raw[i], &single);
+          same = same && (memcmp(&single, &out[i], sizeof(single)) == 0);
+          benchSpec_Compensate(&raw[i], &single);
+          same = same && (memcmp(&single, &out[i], sizeof(single)) == 0);
+     }
+     HOSTTEST_CHECK(same);
+}
@@ -0,0 +1,203 @@
+/**
+ * \file bench_medfilt.c
+ * \author Ugurcan OZTURK
+ * \brief	Median Filter Host Benchmark Source File
+ * \date 17.10.2026
+ *
+ * MEDFILT against the old linked-list filter on ADXL345-like traces:
+ * equal medians once the old zero-filled window has flushed, and host time
+ * per sample of the old filter, MEDFILT_PutU16 and MEDFILT_Block.
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <math.h>
+#include "medfilt.h"
+#include "medfilt_ref.h"
+#include "hosttest.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    BENCH_RATE_HZ             3200
+#define    BENCH_SAMPLES             (BENCH_RATE_HZ * 10)
+#define    BENCH_PASSES              2     /* The first pass warms the caches */
+#define    BENCH_BLOCK               512   /* Samples per MEDFILT_Block call */
+#define    BENCH_OFFSET              8192  /* Keeps the signed traces above the old filter stopper */
+#define    BENCH_FIFO_SAMPLES        32    /* Samples per axis of one FIFO drain */
+#define    BENCH_FIFO_WINDOW         5
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static const uint16_t windows[] = { 3, 5, 7, 9, 31, 101 };
+
+static int16_t trace[3][BENCH_SAMPLES];
+static uint16_t in[BENCH_SAMPLES];
+static uint16_t outRef[BENCH_SAMPLES];
+static uint16_t outPut[BENCH_SAMPLES];
+static uint16_t outBlock[BENCH_SAMPLES];
+static int16_t xyz[3 * BENCH_SAMPLES];
+static uint32_t storage[3][MEDFILT_STORAGE_WORDS(MEDREF_WINDOW_MAX)];
+static MEDREF_t ref;
+static uint32_t seed = 1;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Deterministic pseudo random number
+ * \param range Number of values
+ * \return 0..range-1
+ */
+static int32_t HOSTTEST_Rand(int32_t range);
+
+/** \brief  Fill the x, y and z traces: vibration, noise and impulsive spikes
+ * \param[] Nothing
+ * \return Nothing
+ */
+static void HOSTTEST_Traces(void);
+
+/** \brief  Every 0/1 input of the full network windows gives the majority bit
+ * \param[] Nothing
+ * \return Nothing
+ */
+static void HOSTTEST_MedfiltNetworks(void);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static int32_t HOSTTEST_Rand(int32_t range){
+
+     seed = seed * 1103515245u + 12345u;
+
+     return (int32_t)((seed >> 16) % (uint32_t)range);
+}
+
+static void HOSTTEST_Traces(void){
+
+     double t;
+
+     for(int i = 0; i < BENCH_SAMPLES; i++){
+          t = (double)i / BENCH_RATE_HZ;
+          trace[0][i] = (int16_t)lrint(12.0 * sin(2.0 * M_PI * 50.0 * t) + HOSTTEST_Rand(9) - 4 +
+                                       ((HOSTTEST_Rand(200) == 0) ? (HOSTTEST_Rand(2) ? 900 : -900) : 0));
+          trace[1][i] = (int16_t)lrint(-256.0 + 40.0 * sin(2.0 * M_PI * 13.0 * t) + HOSTTEST_Rand(17) - 8);
+          trace[2][i] = (int16_t)lrint(256.0 * cos(2.0 * M_PI * 0.5 * t) + HOSTTEST_Rand(5) - 2 +
+                                       ((HOSTTEST_Rand(50) == 0) ? 4000 : 0));
+     }
+}
+
+static void HOSTTEST_MedfiltNetworks(void){
+
+     MEDFILT_t filt;
+     uint32_t failed = 0;
+     uint16_t median = 0, ones;
+
+     for(uint16_t window = 3; window <= MEDFILT_NETWORK_MAX; window += 2){
+          for(uint32_t mask = 0; mask < (1u << window); mask++){
+               MEDFILT_Init(&filt, MEDFILT_TYPE_U16, storage[0], window);
+               ones = 0;
+               for(uint16_t j = 0; j < window; j++){
+                    ones += (mask >> j) & 1u;
+                    median = MEDFILT_PutU16(&filt, (mask >> j) & 1u);
+               }
+               failed += (median != (ones > window / 2));
+          }
+     }
+     HOSTTEST_CHECK(failed == 0);
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+void HOSTTEST_BenchMedian(void){
+
+     MEDFILT_t filt;
+     MEDFILT_t axes[3];
+     bool same;
+     uint16_t window;
+     uint64_t startNs;
+     double refNs, putNs, blockNs;
+
+     printf("median filter: linked list reference, MEDFILT put and block\n");
+
+     HOSTTEST_Traces();
+     HOSTTEST_MedfiltNetworks();
+
+     for(size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++){
+          window = windows[w];
+          for(int axis = 0; axis < 3; axis++){
+               /* The old filter reserves 0 and starts from a zero-filled window */
+               for(int i = 0; i < BENCH_SAMPLES; i++){
+                    in[i] = (uint16_t)(trace[axis][i] + BENCH_OFFSET);
+               }
+
+               for(int pass = 0; pass < BENCH_PASSES; pass++){
+                    MEDREF_Init(&ref, window);
+                    startNs = HOSTTEST_NowNs();
+                    for(int i = 0; i < BENCH_SAMPLES; i++){
+                         outRef[i] = MEDREF_Put(&ref, in[i]);
+                    }
+                    refNs = (double)(HOSTTEST_NowNs() - startNs) / BENCH_SAMPLES;
+
+                    MEDFILT_Init(&filt, MEDFILT_TYPE_U16, storage[0], window);
+                    startNs = HOSTTEST_NowNs();
+                    for(int i = 0; i < BENCH_SAMPLES; i++){
+                         outPut[i] = MEDFILT_PutU16(&filt, in[i]);
+                    }
+                    putNs = (double)(HOSTTEST_NowNs() - startNs) / BENCH_SAMPLES;
+
+                    MEDFILT_Init(&filt, MEDFILT_TYPE_U16, storage[0], window);
+                    startNs = HOSTTEST_NowNs();
+                    for(int i = 0; i < BENCH_SAMPLES; i += BENCH_BLOCK){
+                         MEDFILT_Block(&filt, &in[i], &outBlock[i], (BENCH_SAMPLES - i < BENCH_BLOCK) ? BENCH_SAMPLES - i : BENCH_BLOCK, 1);
+                    }
+                    blockNs = (double)(HOSTTEST_NowNs() - startNs) / BENCH_SAMPLES;
+               }
+
+               same = true;
+               for(int i = 0; i < BENCH_SAMPLES; i++){
+                    same = same && (outPut[i] == outBlock[i]) && ((i < 2 * window) || (outPut[i] == outRef[i]));
+               }
+               printf("  window %3u axis %c: list %6.1f, put %6.1f, block %6.1f ns/sample, %4.1fx\n",
+                      window, "xyz"[axis], refNs, putNs, blockNs, refNs / blockNs);
+               HOSTTEST_CHECK(same);
+          }
+     }
+
+     /* FIFO path: one axis of interleaved signed x, y, z filtered in place */
+     for(int i = 0; i < BENCH_SAMPLES; i++){
+          for(int axis = 0; axis < 3; axis++){
+               xyz[3 * i + axis] = trace[axis][i];
+          }
+     }
+     for(int axis = 0; axis < 3; axis++){
+          MEDFILT_Init(&axes[axis], MEDFILT_TYPE_S16, storage[axis], BENCH_FIFO_WINDOW);
+     }
+     startNs = HOSTTEST_NowNs();
+     for(int i = 0; i < BENCH_SAMPLES; i += BENCH_FIFO_SAMPLES){
+          for(int axis = 0; axis < 3; axis++){
+               MEDFILT_Block(&axes[axis], &xyz[3 * i + axis], &xyz[3 * i + axis], BENCH_FIFO_SAMPLES, 3);
+          }
+     }
+     printf("  FIFO drains of %d, window %d: %.1f ns per axis sample\n", BENCH_FIFO_SAMPLES, BENCH_FIFO_WINDOW,
+            (double)(HOSTTEST_NowNs() - startNs) / (3.0 * BENCH_SAMPLES));
+
+     same = true;
+     for(int axis = 0; axis < 3; axis++){
+          MEDFILT_Init(&axes[axis], MEDFILT_TYPE_S16, storage[axis], BENCH_FIFO_WINDOW);
+          for(int i = 0; i < BENCH_SAMPLES; i++){
+               same = same && (MEDFILT_PutS16(&axes[axis], trace[axis][i]) == xyz[3 * i + axis]);
+          }
+     }
+     HOSTTEST_CHECK(same);
+}
@@ -0,0 +1,97 @@
+/**
+ * \file hosttest.h
+ * \author Ugurcan OZTURK
+ * \brief	Host Test Application Header File
+ * \date 17.10.2026
+ */
+
+#ifndef HOSTTEST_H_
+#define HOSTTEST_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+
+/* Count a failed condition and print where it failed */
+#define    HOSTTEST_CHECK(cond)      HOSTTEST_Check((cond), #cond, __FILE__, __LINE__)
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Record one check result
+ * \param pass Condition result
+ * \param expr Condition text
+ * \param file Source file
+ * \param line Source line
+ * \return pass
+ */
+bool HOSTTEST_Check(bool pass, const char *expr, const char *file, int line);
+
+/** \brief  Monotonic host clock for benchmarks, independent of the simulated bus time
+ * \param[] Nothing
+ * \return Time (ns)
+ */
+uint64_t HOSTTEST_NowNs(void);
+
+/** \brief  BMX280 driver against the simulated BME280 and BMP280
+ * \param[] Nothing
+ * \return Nothing
+ */
+void HOSTTEST_Bmx280(void);
+
+/** \brief  ADXL345 driver against the simulated I2C part
+ * \param[] Nothing
+ * \return Nothing
+ */
+void HOSTTEST_Adxl345(void);
+
+/** \brief  ADXL345 driver against the simulated SPI part, run after the I2C
+ *          test since the driver keeps the SPI device once initialized
+ * \param[] Nothing
+ * \return Nothing
+ */
+void HOSTTEST_Adxl345Spi(void);
+
+/** \brief  Tone frequency and amplitude of every FFT size, with a timing run
+ * \param[] Nothing
+ * \return Nothing
+ */
+void HOSTTEST_Spectrum(void);
+
+/** \brief  Stuck SDA, clock stretching, recovery time and quarantine of the bus layer
+ * \param[] Nothing
+ * \return Nothing
+ */
+void HOSTTEST_I2cbusFaults(void);
+
+/** \brief  Pressure error and time of the 64 bit and 32 bit integer compensation
+ *          against the datasheet double formulas
+ * \param[] Nothing
+ * \return Nothing
+ */
+void HOSTTEST_BenchPressure(void);
+
+/** \brief  Error against the double formulas and time per sample of every
+ *          compensation variant: kernels, driver, batch and specialized
+ * \param[] Nothing
+ * \return Nothing
+ */
+void HOSTTEST_BenchCompensation(void);
+
+/** \brief  MEDFILT against the old linked-list median filter, equal results
+ *          and time per sample for every window length
+ * \param[] Nothing
+ * \return Nothing
+ */
+void HOSTTEST_BenchMedian(void);
+
+#endif /* HOSTTEST_H_ */
@@ -0,0 +1,97 @@
+/**
+ * \file medfilt_ref.c
+ * \author Ugurcan OZTURK
+ * \brief	Reference Linked-List Median Filter Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <string.h>
+#include "medfilt_ref.h"
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+void MEDREF_Init(MEDREF_t *ref, uint16_t window){
+
+     memset(ref->buffer, 0, sizeof(ref->buffer));
+     ref->datpoint = ref->buffer;
+     ref->small.point = NULL;
+     ref->small.value = MEDREF_STOPPER;
+     ref->big.point = &ref->small;
+     ref->big.value = 0;
+     ref->window = window;
+}
+
+uint16_t MEDREF_Put(MEDREF_t *ref, uint16_t data){
+
+     MEDREF_pair_t *successor;        /* Pointer to successor of replaced data item */
+     MEDREF_pair_t *scan;             /* Pointer used to scan down the sorted list */
+     MEDREF_pair_t *scanold;          /* Previous value of scan */
+     MEDREF_pair_t *median;           /* Pointer to median */
+     uint16_t i;
+
+     if(data == MEDREF_STOPPER){
+          data = MEDREF_STOPPER + 1;
+     }
+
+     if((++ref->datpoint - ref->buffer) >= ref->window){
+          ref->datpoint = ref->buffer;
+     }
+
+     ref->datpoint->value = data;
+     successor = ref->datpoint->point;
+     median = &ref->big;
+     scanold = NULL;
+     scan = &ref->big;
+
+     /* Handle chain-out of first item in chain as special case */
+     if(scan->point == ref->datpoint){
+          scan->point = successor;
+     }
+     scanold = scan;
+     scan = scan->point;
+
+     /* Loop through the chain, normal loop exit via break */
+     for(i = 0; i < ref->window; ++i){
+          /* Odd-numbered item in chain */
+          if(scan->point == ref->datpoint){
+               scan->point = successor;
+          }
+          if(scan->value < data){
+               ref->datpoint->point = scanold->point;
+               scanold->point = ref->datpoint;
+               data = MEDREF_STOPPER;
+          }
+
+          /* Step median pointer down chain after doing odd-numbered element */
+          median = median->point;
+          if(scan == &ref->small){
+               break;
+          }
+          scanold = scan;
+          scan = scan->point;
+
+          /* Even-numbered item in chain */
+          if(scan->point == ref->datpoint){
+               scan->point = successor;
+          }
+          if(scan->value < data){
+               ref->datpoint->point = scanold->point;
+               scanold->point = ref->datpoint;
+               data = MEDREF_STOPPER;
+          }
+          if(scan == &ref->small){
+               break;
+          }
+          scanold = scan;
+          scan = scan->point;
+     }
+
+     return median->value;
+}
@@ -0,0 +1,71 @@
+/**
+ * \file medfilt_ref.h
+ * \author Ugurcan OZTURK
+ * \brief	Reference Linked-List Median Filter Header File
+ * \date 17.10.2026
+ *
+ * The sorted linked-list median filter the ADXL345 driver used before
+ * MEDFILT, with its static state moved into a caller-owned context so one
+ * instance per window length can run. Kept only as the host reference.
+ */
+
+#ifndef MEDFILT_REF_H_
+#define MEDFILT_REF_H_
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    MEDREF_STOPPER            0     /* Smaller than any sample, 0 is read as 1 */
+#define    MEDREF_WINDOW_MAX         101
+
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+
+/** @struct MEDREF_pair_t
+*   @brief One sample and its link in the sorted chain
+*/
+typedef struct MEDREF_pair{
+
+    struct MEDREF_pair *point;    /* Next smaller sample */
+    uint16_t            value;
+}MEDREF_pair_t;
+
+/** @struct MEDREF_t
+*   @brief Filter state, the statics of the old driver function
+*/
+typedef struct{
+
+    MEDREF_pair_t  buffer[MEDREF_WINDOW_MAX];
+    MEDREF_pair_t *datpoint;      /* Pointer into circular buffer of data */
+    MEDREF_pair_t  small;         /* Chain stopper */
+    MEDREF_pair_t  big;           /* Head (largest) of linked list */
+    uint16_t       window;
+}MEDREF_t;
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Set up the zero-filled state of the old static filter
+ * \param ref Filter
+ * \param window Odd window length, 1..MEDREF_WINDOW_MAX
+ * \return Nothing
+ */
+void MEDREF_Init(MEDREF_t *ref, uint16_t window);
+
+/** \brief  Add one sample, the old adxl_median_filter
+ * \param ref Filter
+ * \param data Sample
+ * \return Median of the window, zero-filled at start
+ */
+uint16_t MEDREF_Put(MEDREF_t *ref, uint16_t data);
+
+#endif /* MEDFILT_REF_H_ */
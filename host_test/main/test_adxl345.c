@@ -0,0 +1,206 @@
+/**
+ * \file test_adxl345.c
+ * \author Ugurcan OZTURK
+ * \brief	ADXL345 Host Test Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "i2csim.h"
+#include "i2cbus.h"
+#include "adxl345.h"
+#include "hosttest.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    TEST_PORT                 I2C_NUM_1
+#define    TEST_ADDR                 0x53
+#define    TEST_STEP_MG              125   /* Exact in LSB at every range */
+#define    TEST_RAMP_LEN             32    /* X ramps 0..31 steps, below the 4 g limit */
+#define    TEST_FILL_MS              60    /* More than the 16 entry watermark at 400 Hz */
+#define    TEST_SPI_HOST             SPI2_HOST
+#define    TEST_SPI_CS_IO            26
+#define    TEST_SPI_PORT             I2CSIM_SPI_PORT(TEST_SPI_HOST)
+#define    TEST_SPI_HEADER_BITS      8     /* Header byte of every transaction */
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static I2CBUS_device_t adxl345Dev = { .port = TEST_PORT, .addr = TEST_ADDR, .clkSpeed = 400000, .timeoutMs = 20 };
+static ADXL_sample_t block[ADXL345_FIFO_ENTRIES_MAX];
+static const ADXL_spiConfig_t spiConfig = {
+     .host     = TEST_SPI_HOST,
+     .mosiIo   = 13,
+     .misoIo   = 27,
+     .sclkIo   = 14,
+     .csIo     = TEST_SPI_CS_IO,
+     .clkSpeed = 8000000,     /* Above the part limit, the driver caps it */
+};
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Acceleration source, x ramps with the sample index and y holds one step
+ * \param arg Unused
+ * \param index Sample counter
+ * \param mg Acceleration in milli-g
+ * \return Nothing
+ */
+static void HOSTTEST_Ramp(void *arg, uint32_t index, int32_t mg[3]);
+
+/** \brief  Whether a block continues the ramp without a gap
+ * \param samples Drained samples
+ * \param count Number of samples
+ * \param prev Ramp position of the previous sample, -1 when none, updated
+ * \return true when every sample is the next ramp position
+ */
+static bool HOSTTEST_Contiguous(const ADXL_sample_t *samples, size_t count, int32_t *prev);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static void HOSTTEST_Ramp(void *arg, uint32_t index, int32_t mg[3]){
+
+     mg[0] = (int32_t)(index % TEST_RAMP_LEN) * TEST_STEP_MG;
+     mg[1] = TEST_STEP_MG;
+     mg[2] = 1000;
+}
+
+static bool HOSTTEST_Contiguous(const ADXL_sample_t *samples, size_t count, int32_t *prev){
+
+     int32_t pos;
+
+     for(size_t i = 0; i < count; i++){
+          /* y is one ramp step in the current scaling */
+          if(samples[i].y_s16 == 0 || samples[i].x_s16 % samples[i].y_s16 != 0){
+               return false;
+          }
+          pos = samples[i].x_s16 / samples[i].y_s16;
+          if(*prev >= 0 && pos != (*prev + 1) % TEST_RAMP_LEN){
+               return false;
+          }
+          *prev = pos;
+     }
+
+     return true;
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+void HOSTTEST_Adxl345(void){
+
+     I2CBUS_busConfig_t busConf = { .port = TEST_PORT, .sdaIo = 18, .sclIo = 19, .clkSpeed = 400000 };
+     int32_t prev = -1;
+     uint8_t devId = 0;
+     uint8_t reg;
+     size_t count;
+
+     printf("adxl345 i2c\n");
+
+     I2CSIM_Reset();
+     I2CSIM_AddDevice(TEST_PORT, TEST_ADDR, I2CSIM_ADXL345);
+     HOSTTEST_CHECK(I2CBUS_Init(&busConf) == ESP_OK);
+
+     ADXL345_Init(&adxl345Dev);
+     HOSTTEST_CHECK(adxl_register_read(REGISTER_DEVID_ADDR, &devId, sizeof(devId)) == ESP_OK);
+     HOSTTEST_CHECK(devId == ADXL345_DEVID);
+     HOSTTEST_CHECK(ADXL345_SetWatermark(16) == ESP_OK);
+     I2CSIM_PeekReg(TEST_PORT, TEST_ADDR, REGISTER_FIFO_CTL_ADDR, &reg);
+     HOSTTEST_CHECK((reg & 0x1F) == 16 && (reg & 0xC0) != 0);
+
+     /* Drop what queued before the ramp source was attached */
+     I2CSIM_SetAdxlSource(TEST_PORT, TEST_ADDR, HOSTTEST_Ramp, NULL);
+     ADXL345_ReadFifo(block, ADXL345_FIFO_ENTRIES_MAX, &count);
+
+     /* Full drain, every entry in order */
+     vTaskDelay(pdMS_TO_TICKS(TEST_FILL_MS));
+     HOSTTEST_CHECK(ADXL345_ReadFifo(block, ADXL345_FIFO_ENTRIES_MAX, &count) == ESP_OK);
+     HOSTTEST_CHECK(count >= 16);
+     HOSTTEST_CHECK(HOSTTEST_Contiguous(block, count, &prev));
+
+     /* A short buffer leaves the rest queued, the next drain continues */
+     vTaskDelay(pdMS_TO_TICKS(TEST_FILL_MS));
+     HOSTTEST_CHECK(ADXL345_ReadFifo(block, 4, &count) == ESP_OK);
+     HOSTTEST_CHECK(count == 4);
+     HOSTTEST_CHECK(HOSTTEST_Contiguous(block, count, &prev));
+     HOSTTEST_CHECK(ADXL345_ReadFifo(block, ADXL345_FIFO_ENTRIES_MAX, &count) == ESP_OK);
+     HOSTTEST_CHECK(count != 0);
+     HOSTTEST_CHECK(HOSTTEST_Contiguous(block, count, &prev));
+
+     /* A failed drain returns no samples */
+     vTaskDelay(pdMS_TO_TICKS(TEST_FILL_MS));
+     I2CSIM_InjectNack(TEST_PORT, TEST_ADDR, I2CBUS_RETRY_MAX + 1);
+     HOSTTEST_CHECK(ADXL345_ReadFifo(block, ADXL345_FIFO_ENTRIES_MAX, &count) != ESP_OK);
+     HOSTTEST_CHECK(count == 0);
+     prev = -1;
+     HOSTTEST_CHECK(ADXL345_ReadFifo(block, ADXL345_FIFO_ENTRIES_MAX, &count) == ESP_OK);
+     HOSTTEST_CHECK(HOSTTEST_Contiguous(block, count, &prev));
+}
+
+void HOSTTEST_Adxl345Spi(void){
+
+     ADXL_motionConfig_t motion = { .actThresh_u8 = 4, .inactThresh_u8 = 2, .inactTime_u8 = 10, .ctl = { .u8 = 0xFF } };
+     int32_t prev = -1;
+     uint64_t busNs;
+     uint8_t devId = 0;
+     uint8_t reg;
+     size_t count;
+
+     printf("adxl345 spi\n");
+
+     /* No acknowledge on SPI, an absent part reads 0xFF */
+     I2CSIM_Reset();
+     HOSTTEST_CHECK(ADXL345_InitSpi(&spiConfig) == ESP_ERR_NOT_FOUND);
+
+     I2CSIM_AddSpiDevice(TEST_SPI_HOST, TEST_SPI_CS_IO, I2CSIM_ADXL345);
+     HOSTTEST_CHECK(ADXL345_InitSpi(&spiConfig) == ESP_OK);
+
+     /* Single byte read: R set, MB clear */
+     HOSTTEST_CHECK(adxl_register_read(REGISTER_DEVID_ADDR, &devId, sizeof(devId)) == ESP_OK);
+     HOSTTEST_CHECK(devId == ADXL345_DEVID);
+
+     /* Single byte write: R and MB clear */
+     HOSTTEST_CHECK(ADXL345_SetDataRate(DATARATE3200_BANDWIDTH1600) == ESP_OK);
+     I2CSIM_PeekReg(TEST_SPI_PORT, TEST_SPI_CS_IO, REGISTER_BW_RATE_ADDR, &reg);
+     HOSTTEST_CHECK((reg & 0x0F) == DATARATE3200_BANDWIDTH1600);
+
+     /* Multi byte write: MB set, the address increments over 0x24..0x27 */
+     HOSTTEST_CHECK(ADXL345_ConfigMotion(&motion) == ESP_OK);
+     I2CSIM_PeekReg(TEST_SPI_PORT, TEST_SPI_CS_IO, REGISTER_THRESH_ACT_ADDR, &reg);
+     HOSTTEST_CHECK(reg == motion.actThresh_u8);
+     I2CSIM_PeekReg(TEST_SPI_PORT, TEST_SPI_CS_IO, REGISTER_THRESH_INACT_ADDR, &reg);
+     HOSTTEST_CHECK(reg == motion.inactThresh_u8);
+     I2CSIM_PeekReg(TEST_SPI_PORT, TEST_SPI_CS_IO, REGISTER_TIME_INACT_ADDR, &reg);
+     HOSTTEST_CHECK(reg == motion.inactTime_u8);
+     I2CSIM_PeekReg(TEST_SPI_PORT, TEST_SPI_CS_IO, REGISTER_ACT_INACT_CTL_ADDR, &reg);
+     HOSTTEST_CHECK(reg == motion.ctl.u8);
+
+     /* FIFO drain: one queued R|MB read of DATAX0..DATAZ1 per entry, without MB
+        every axis would read DATAX0 and the ramp would not advance */
+     HOSTTEST_CHECK(ADXL345_SetWatermark(16) == ESP_OK);
+     I2CSIM_SetAdxlSource(TEST_SPI_PORT, TEST_SPI_CS_IO, HOSTTEST_Ramp, NULL);
+     ADXL345_ReadFifo(block, ADXL345_FIFO_ENTRIES_MAX, &count);
+     vTaskDelay(pdMS_TO_TICKS(TEST_FILL_MS));
+     busNs = I2CSIM_SpiBusTimeNs(TEST_SPI_HOST);
+     HOSTTEST_CHECK(ADXL345_ReadFifo(block, ADXL345_FIFO_ENTRIES_MAX, &count) == ESP_OK);
+     busNs = I2CSIM_SpiBusTimeNs(TEST_SPI_HOST) - busNs;
+     HOSTTEST_CHECK(count >= 16);
+     HOSTTEST_CHECK(HOSTTEST_Contiguous(block, count, &prev));
+
+     /* Every entry costs a header and a frame at no more than the 5 MHz cap */
+     HOSTTEST_CHECK(busNs >= (uint64_t)count * (TEST_SPI_HEADER_BITS + 8 * ADXL345_FRAME_SIZE) * 1000000000ULL / ADXL345_SPI_CLK_MAX);
+}
@@ -0,0 +1,135 @@
+/**
+ * \file test_bmx280.c
+ * \author Ugurcan OZTURK
+ * \brief	BMX280 Host Test Source File
+ * \date 17.10.2026
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "i2csim.h"
+#include "i2cbus.h"
+#include "bmx280.h"
+#include "hosttest.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    TEST_PORT                 I2C_NUM_0
+#define    TEST_BME280_ADDR          0x76
+#define    TEST_BMP280_ADDR          0x77
+#define    TEST_RAW_PRESS            415148  /* Datasheet compensation example */
+#define    TEST_RAW_TEMP             519888
+#define    TEST_RAW_HUM              30000
+#define    TEST_TEMP                 2508      /* 0.01 DegC */
+#define    TEST_PRESS_Q8             25767233  /* Pa in Q24.8 */
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static I2CBUS_device_t bme280Dev = { .port = TEST_PORT, .addr = TEST_BME280_ADDR, .clkSpeed = 400000, .timeoutMs = 20 };
+static I2CBUS_device_t bmp280Dev = { .port = TEST_PORT, .addr = TEST_BMP280_ADDR, .clkSpeed = 400000, .timeoutMs = 20 };
+static BMX280_t bme280Ctx;
+static BMX280_t bmp280Ctx;
+
+static const BMX280_config_t forcedConfig = {
+     .mode      = BME280_SLEEP_MODE,
+     .tempOver  = TEMP_OVERSAMPLING_X2,
+     .pressOver = PRESS_OVERSAMPLING_X16,
+     .humOver   = HUM_OVERSAMPLING_X1,
+     .filter    = BME280_FILTER_OFF,
+     .standby   = BME280_STANDBY_5,
+};
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Check one measurement against the datasheet example
+ * \param ctx Context of the part
+ * \param raw Uncompensated snapshot
+ * \return Nothing
+ */
+static void HOSTTEST_CheckMeasurement(const BMX280_t *ctx, const BME280_rawData_t *raw);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static void HOSTTEST_CheckMeasurement(const BMX280_t *ctx, const BME280_rawData_t *raw){
+
+     BME280_data_t data;
+
+     HOSTTEST_CHECK(raw->press_s32 == TEST_RAW_PRESS);
+     HOSTTEST_CHECK(raw->temp_s32 == TEST_RAW_TEMP);
+     HOSTTEST_CHECK(raw->hum_s32 == (ctx->hasHum ? TEST_RAW_HUM : BME280_HUM_SKIPPED));
+     HOSTTEST_CHECK(BMX280_Compensate(ctx, raw, &data) == ESP_OK);
+     HOSTTEST_CHECK(data.temp_s32 == TEST_TEMP);
+     HOSTTEST_CHECK(data.press_u32 == TEST_PRESS_Q8);
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+void HOSTTEST_Bmx280(void){
+
+     I2CBUS_busConfig_t busConf = { .port = TEST_PORT, .sdaIo = 21, .sclIo = 22, .clkSpeed = 400000 };
+     uint8_t bmeBurst[BMX280_BURST_READ_SIZE];
+     uint8_t bmpBurst[BMX280_BURST_NO_HUM_SIZE];
+     I2CBUS_batchRead_t reads[2] = {
+          { .dev = &bme280Dev, .reg = REGISTER_PRESS_MSB_ADDR, .data = bmeBurst, .len = sizeof(bmeBurst) },
+          { .dev = &bmp280Dev, .reg = REGISTER_PRESS_MSB_ADDR, .data = bmpBurst, .len = sizeof(bmpBurst) },
+     };
+     BME280_rawData_t raw;
+     uint32_t waitUs;
+     uint8_t reg;
+
+     printf("bmx280\n");
+
+     I2CSIM_Reset();
+     I2CSIM_AddDevice(TEST_PORT, TEST_BME280_ADDR, I2CSIM_BME280);
+     I2CSIM_AddDevice(TEST_PORT, TEST_BMP280_ADDR, I2CSIM_BMP280);
+     I2CSIM_SetBmx280Raw(TEST_PORT, TEST_BME280_ADDR, TEST_RAW_PRESS, TEST_RAW_TEMP, TEST_RAW_HUM);
+     I2CSIM_SetBmx280Raw(TEST_PORT, TEST_BMP280_ADDR, TEST_RAW_PRESS, TEST_RAW_TEMP, TEST_RAW_HUM);
+     HOSTTEST_CHECK(I2CBUS_Init(&busConf) == ESP_OK);
+
+     /* Init identifies the variant and writes the configuration */
+     HOSTTEST_CHECK(BMX280_Init(&bme280Ctx, &bme280Dev, &forcedConfig) == ESP_OK);
+     HOSTTEST_CHECK(BMX280_Init(&bmp280Ctx, &bmp280Dev, &forcedConfig) == ESP_OK);
+     HOSTTEST_CHECK(bme280Ctx.hasHum && !bmp280Ctx.hasHum);
+     I2CSIM_PeekReg(TEST_PORT, TEST_BME280_ADDR, REGISTER_CTRL_MEAS_ADDR, &reg);
+     HOSTTEST_CHECK(reg == bme280Ctx.ctrlMeas.u8);
+     I2CSIM_PeekReg(TEST_PORT, TEST_BME280_ADDR, REGISTER_CTRL_HUM_ADDR, &reg);
+     HOSTTEST_CHECK(reg == bme280Ctx.ctrlHum.u8);
+
+     /* One forced measurement per part, the part returns to sleep */
+     HOSTTEST_CHECK(BMX280_ReadForced(&bme280Ctx, &raw) == ESP_OK);
+     HOSTTEST_CheckMeasurement(&bme280Ctx, &raw);
+     HOSTTEST_CHECK(BMX280_ReadForced(&bmp280Ctx, &raw) == ESP_OK);
+     HOSTTEST_CheckMeasurement(&bmp280Ctx, &raw);
+     I2CSIM_PeekReg(TEST_PORT, TEST_BME280_ADDR, REGISTER_CTRL_MEAS_ADDR, &reg);
+     HOSTTEST_CHECK((reg & 0x03) == 0);
+
+     /* Both parts triggered together, one wait, one batched read */
+     waitUs = BMX280_MeasureTimeUs(&bme280Ctx);
+     if(BMX280_MeasureTimeUs(&bmp280Ctx) > waitUs){
+          waitUs = BMX280_MeasureTimeUs(&bmp280Ctx);
+     }
+     HOSTTEST_CHECK(BMX280_SetMode(&bme280Ctx, BME280_FORCED_MODE) == ESP_OK);
+     HOSTTEST_CHECK(BMX280_SetMode(&bmp280Ctx, BME280_FORCED_MODE) == ESP_OK);
+     vTaskDelay((waitUs + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000) + 1);
+     HOSTTEST_CHECK(I2CBUS_BatchRead(reads, 2) == ESP_OK);
+     BMX280_DecodeRawData(&bme280Ctx, bmeBurst, &raw);
+     HOSTTEST_CheckMeasurement(&bme280Ctx, &raw);
+     BMX280_DecodeRawData(&bmp280Ctx, bmpBurst, &raw);
+     HOSTTEST_CheckMeasurement(&bmp280Ctx, &raw);
+}
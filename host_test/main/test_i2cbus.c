@@ -0,0 +1,138 @@
+/**
+ * \file test_i2cbus.c
+ * \author Ugurcan OZTURK
+ * \brief	I2C Bus Fault Injection Host Test Source File
+ * \date 17.10.2026
+ *
+ * Stuck SDA and clock stretching past the timeout: bus clear, retries and
+ * the measured recovery time against the worst case of i2cbus.h, then
+ * quarantine after repeated failures and its release.
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include "esp_timer.h"
+#include "i2csim.h"
+#include "i2cbus.h"
+#include "bme280.h"
+#include "hosttest.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    TEST_PORT                 I2C_NUM_0
+#define    TEST_ADDR                 0x76
+#define    TEST_TIMEOUT_MS           20
+#define    TEST_CLEAR_MAX_US         200   /* 23 half periods of 5 us and the driver reinstall */
+
+/* Every attempt times out, the backoffs are busy waited, one bus clear per retry */
+#define    TEST_WORST_CASE_US        ((I2CBUS_RETRY_MAX + 1) * TEST_TIMEOUT_MS * 1000 +                       \
+                                      ((1 << I2CBUS_RETRY_MAX) - 1) * I2CBUS_BACKOFF_US +                       \
+                                      I2CBUS_RETRY_MAX * TEST_CLEAR_MAX_US)
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static I2CBUS_device_t testDev = { .port = TEST_PORT, .addr = TEST_ADDR, .clkSpeed = 400000, .timeoutMs = TEST_TIMEOUT_MS };
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Chip-ID read with its duration on the simulated clock
+ * \param elapsedUs Call duration (us)
+ * \return Bus status
+ */
+static esp_err_t HOSTTEST_TimedRead(uint32_t *elapsedUs);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static esp_err_t HOSTTEST_TimedRead(uint32_t *elapsedUs){
+
+     int64_t startUs = esp_timer_get_time();
+     uint8_t id = 0;
+     esp_err_t err;
+
+     err = I2CBUS_Read(&testDev, REGISTER_ID_ADDR, &id);
+     *elapsedUs = (uint32_t)(esp_timer_get_time() - startUs);
+     if(err == ESP_OK){
+          HOSTTEST_CHECK(id == BME280_CHIP_ID);
+     }
+
+     return err;
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+void HOSTTEST_I2cbusFaults(void){
+
+     I2CBUS_busConfig_t busConf = { .port = TEST_PORT, .sdaIo = 21, .sclIo = 22, .clkSpeed = 400000 };
+     I2CBUS_stats_t stats;
+     uint64_t busTimeNs;
+     uint32_t elapsedUs;
+
+     printf("i2cbus faults, worst case %u us\n", (unsigned)TEST_WORST_CASE_US);
+
+     I2CSIM_Reset();
+     I2CSIM_AddDevice(TEST_PORT, TEST_ADDR, I2CSIM_BME280);
+     HOSTTEST_CHECK(I2CBUS_Init(&busConf) == ESP_OK);
+
+     /* A slave holding SDA for a few clocks is released by the first bus clear */
+     I2CSIM_StickSda(TEST_PORT, 5);
+     HOSTTEST_CHECK(HOSTTEST_TimedRead(&elapsedUs) == ESP_OK);
+     I2CBUS_GetStats(&testDev, &stats);
+     printf("  stuck SDA, released: %lu us, recovery %lu us\n", (unsigned long)elapsedUs, (unsigned long)stats.maxRecoverUs);
+     HOSTTEST_CHECK(stats.timeoutCount == 1 && stats.retryCount == 1 && stats.busClearCount == 1);
+     HOSTTEST_CHECK(stats.maxRecoverUs > 0 && stats.maxRecoverUs <= elapsedUs);
+
+     /* Held through every bus clear: all attempts time out */
+     I2CBUS_ResetStats(&testDev);
+     I2CSIM_StickSda(TEST_PORT, I2CBUS_CLEAR_CLOCKS * (I2CBUS_RETRY_MAX + 1));
+     HOSTTEST_CHECK(HOSTTEST_TimedRead(&elapsedUs) == ESP_ERR_TIMEOUT);
+     I2CBUS_GetStats(&testDev, &stats);
+     printf("  stuck SDA, held: %lu us, recovery %lu us\n", (unsigned long)elapsedUs, (unsigned long)stats.maxRecoverUs);
+     HOSTTEST_CHECK(stats.timeoutCount == I2CBUS_RETRY_MAX + 1);
+     HOSTTEST_CHECK(stats.retryCount == I2CBUS_RETRY_MAX && stats.busClearCount == I2CBUS_RETRY_MAX);
+     HOSTTEST_CHECK(elapsedUs >= (I2CBUS_RETRY_MAX + 1) * TEST_TIMEOUT_MS * 1000 && elapsedUs <= TEST_WORST_CASE_US);
+     HOSTTEST_CHECK(stats.maxRecoverUs <= TEST_WORST_CASE_US);
+
+     /* A good call clears the failure streak */
+     I2CSIM_StickSda(TEST_PORT, 0);
+     HOSTTEST_CHECK(HOSTTEST_TimedRead(&elapsedUs) == ESP_OK);
+
+     /* Stretching past the timeout, I2CBUS_QUARANTINE_FAILS failed calls quarantine the device */
+     I2CBUS_ResetStats(&testDev);
+     I2CSIM_SetClockStretch(TEST_PORT, TEST_ADDR, (TEST_TIMEOUT_MS + 1) * 1000);
+     for(int i = 0; i < I2CBUS_QUARANTINE_FAILS; i++){
+          HOSTTEST_CHECK(HOSTTEST_TimedRead(&elapsedUs) == ESP_ERR_TIMEOUT);
+          HOSTTEST_CHECK(elapsedUs <= TEST_WORST_CASE_US);
+     }
+     I2CBUS_GetStats(&testDev, &stats);
+     printf("  stretched: %lu us per call, recovery %lu us, quarantine %lu\n", (unsigned long)elapsedUs,
+            (unsigned long)stats.maxRecoverUs, (unsigned long)stats.quarantineCount);
+     HOSTTEST_CHECK(stats.retryCount == I2CBUS_QUARANTINE_FAILS * I2CBUS_RETRY_MAX);
+     HOSTTEST_CHECK(stats.maxRecoverUs <= TEST_WORST_CASE_US);
+     HOSTTEST_CHECK(stats.quarantineCount == 1);
+
+     /* Quarantined calls fail at once without bus traffic */
+     I2CSIM_SetClockStretch(TEST_PORT, TEST_ADDR, 0);
+     busTimeNs = I2CSIM_BusTimeNs(TEST_PORT);
+     HOSTTEST_CHECK(HOSTTEST_TimedRead(&elapsedUs) == ESP_ERR_INVALID_STATE);
+     HOSTTEST_CHECK(I2CSIM_BusTimeNs(TEST_PORT) == busTimeNs);
+
+     /* Released after I2CBUS_QUARANTINE_MS, the simulated busy wait advances the clock */
+     esp_rom_delay_us(I2CBUS_QUARANTINE_MS * 1000);
+     HOSTTEST_CHECK(HOSTTEST_TimedRead(&elapsedUs) == ESP_OK);
+     I2CBUS_GetStats(&testDev, &stats);
+     HOSTTEST_CHECK(stats.quarantineCount == 1);
+}
@@ -0,0 +1,66 @@
+/**
+ * \file test_main.c
+ * \author Ugurcan OZTURK
+ * \brief	Host Test Application Source File
+ * \date 17.10.2026
+ *
+ * Runs the sensor drivers against the linux target bus simulator and exits
+ * with a non-zero status when a check fails.
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "hosttest.h"
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+bool HOSTTEST_Check(bool pass, const char *expr, const char *file, int line){
+
+     checkCount++;
+
+     if(!pass){
+          failCount++;
+          printf("FAIL %s:%d: %s\n", file, line, expr);
+     }
+
+     return pass;
+}
+
+uint64_t HOSTTEST_NowNs(void){
+
+     struct timespec now;
+
+     clock_gettime(CLOCK_MONOTONIC, &now);
+
+     return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+void app_main(void){
+
+     HOSTTEST_Bmx280();
+     HOSTTEST_Adxl345();
+     HOSTTEST_Adxl345Spi();
+     HOSTTEST_Spectrum();
+     HOSTTEST_I2cbusFaults();
+     HOSTTEST_BenchPressure();
+     HOSTTEST_BenchCompensation();
+     HOSTTEST_BenchMedian();
+
+     printf("%lu checks, %lu failed\n", (unsigned long)checkCount, (unsigned long)failCount);
+
+     exit((failCount == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,130 @@
+/**
+ * \file test_spectrum.c
+ * \author Ugurcan OZTURK
+ * \brief	Spectrum Host Test Source File
+ * \date 17.10.2026
+ *
+ * Synthetic tones stand in for recorded ADXL345 traces, none are in the
+ * tree: a known frequency and amplitude give an exact expected result.
+ */
+
+
+ /******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "spectrum.h"
+#include "hosttest.h"
+
+/******************************************************************************
+ *** DEFINES
+ ******************************************************************************/
+#define    TEST_RATE_HZ              400
+#define    TEST_TIMING_BLOCKS        200
+#define    TEST_AMP_TOL_PERCENT      3     /* Tone on a bin centre */
+#define    TEST_OFFBIN_TOL_PERCENT   16    /* Tone between bins, Hann scalloping is 15 % */
+
+/******************************************************************************
+ *** STRUCTS
+ ******************************************************************************/
+typedef struct{
+
+    double     freqHz;
+    double     amp;
+    double     offset;       /* DC part, removed before the FFT */
+    uint32_t   tolPercent;
+}HOSTTEST_tone_t;
+
+/******************************************************************************
+ *** VARIABLES
+ ******************************************************************************/
+static const SPECTRUM_size_e sizes[] = { SPECTRUM_SIZE_256, SPECTRUM_SIZE_512, SPECTRUM_SIZE_1024 };
+
+/* 100 Hz and 37.5 Hz are bin centres of every size at 400 Hz */
+static const HOSTTEST_tone_t tones[] = {
+     { 100.0,  200.0,    0.0, TEST_AMP_TOL_PERCENT },
+     {  37.5, 3000.0,  128.0, TEST_AMP_TOL_PERCENT },
+     {  61.3,  300.0, -500.0, TEST_OFFBIN_TOL_PERCENT },
+     /* Deviations above the 2^14 FFT headroom are scaled down, not clipped */
+     { 100.0, 30000.0,   0.0, TEST_AMP_TOL_PERCENT },
+};
+
+static int16_t block[SPECTRUM_SIZE_MAX * SPECTRUM_AXES];
+
+
+/******************************************************************************
+ *** FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/** \brief  Fill a block with a tone on every axis
+ * \param tone Tone
+ * \param size Samples per axis
+ * \return Nothing
+ */
+static void HOSTTEST_Tone(const HOSTTEST_tone_t *tone, size_t size);
+
+
+/******************************************************************************
+ *** LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static void HOSTTEST_Tone(const HOSTTEST_tone_t *tone, size_t size){
+
+     for(size_t n = 0; n < size; n++){
+          for(size_t a = 0; a < SPECTRUM_AXES; a++){
+               block[SPECTRUM_AXES * n + a] = (int16_t)lrint(tone->offset + tone->amp * sin(2.0 * M_PI * tone->freqHz * n / TEST_RATE_HZ));
+          }
+     }
+}
+
+
+/******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+void HOSTTEST_Spectrum(void){
+
+     SPECTRUM_config_t config = { .sampleRateHz_u16 = TEST_RATE_HZ, .bandCount_u8 = 4, .bandEdgesHz_u16 = { 2, 20, 60, 130, 200 } };
+     SPECTRUM_features_t features[SPECTRUM_AXES];
+     uint32_t binDeciHz;
+     uint64_t startNs;
+
+     printf("spectrum\n");
+
+     for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++){
+          config.size = sizes[s];
+          HOSTTEST_CHECK(SPECTRUM_Init(&config) == ESP_OK);
+          binDeciHz = 10 * TEST_RATE_HZ / config.size + 1;
+
+          for(size_t t = 0; t < sizeof(tones) / sizeof(tones[0]); t++){
+               HOSTTEST_Tone(&tones[t], config.size);
+
+               /* One axis of the interleaved block */
+               SPECTRUM_Analyze(&block[1], SPECTRUM_AXES, &features[0]);
+               printf("  N=%4d %6.1f Hz amp %6.0f: peak %5.1f Hz amp %5u\n", config.size, tones[t].freqHz, tones[t].amp,
+                      features[0].peakDeciHz_u16 / 10.0, features[0].peakAmp_u16);
+               HOSTTEST_CHECK(abs((int)features[0].peakDeciHz_u16 - (int)lrint(tones[t].freqHz * 10)) <= (int)binDeciHz);
+               HOSTTEST_CHECK(fabs(features[0].peakAmp_u16 - tones[t].amp) <= tones[t].amp * tones[t].tolPercent / 100);
+
+               /* Same result through the block interface on every axis */
+               HOSTTEST_CHECK(SPECTRUM_Feed(block, config.size) == config.size);
+               HOSTTEST_CHECK(SPECTRUM_Ready());
+               HOSTTEST_CHECK(SPECTRUM_Process(features) == ESP_OK);
+               for(size_t a = 0; a < SPECTRUM_AXES; a++){
+                    HOSTTEST_CHECK(abs((int)features[a].peakDeciHz_u16 - (int)lrint(tones[t].freqHz * 10)) <= (int)binDeciHz);
+               }
+          }
+
+          /* Timing of a full 3 axis block, feed and analysis, after one warm-up block */
+          SPECTRUM_Feed(block, config.size);
+          SPECTRUM_Process(features);
+          startNs = HOSTTEST_NowNs();
+          for(int i = 0; i < TEST_TIMING_BLOCKS; i++){
+               SPECTRUM_Feed(block, config.size);
+               SPECTRUM_Process(features);
+          }
+          printf("  N=%4d %8.1f us per 3 axis block\n", config.size, (HOSTTEST_NowNs() - startNs) / 1000.0 / TEST_TIMING_BLOCKS);
+     }
+}
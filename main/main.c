@@ -5,6 +5,7 @@
 #include "esp_event.h"
 #include "nvs_flash.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_nimble_hci.h"
 #include "nimble/nimble_port.h"
 #include "nimble/nimble_port_freertos.h"
@@ -12,23 +13,84 @@
 #include "services/gap/ble_svc_gap.h"
 #include "services/gatt/ble_svc_gatt.h"
 #include "sdkconfig.h"
-#include "driver/i2c.h"
+#include "i2cbus.h"
+#include "i2casync.h"
 #include "bme280.h"
 #include "adxl345.h"
 #include "bmp280.h"
-
-
-#define I2C_MASTER_SCL_IO             (GPIO_NUM_22)
-#define I2C_MASTER_SDA_IO             (GPIO_NUM_21)
-#define I2C_PORT_NUM_0                ( I2C_NUM_0 )
-#define BME280_SENSOR_ADDR            (    0x76   )
-#define ADXL345_SENSOR_ADDR           (    0x53   )
-#define BMP280_SENSOR_ADDR            (    0x77   )
+#include "bmx280.h"
+#include "sensorscan.h"
+#include "spectrum.h"
+#include "vibfeat.h"
+#include "medfilt.h"
+
+
+#define I2C_BUS0_SCL_IO               (GPIO_NUM_22)
+#define I2C_BUS0_SDA_IO               (GPIO_NUM_21)
+#define I2C_BUS1_SCL_IO               (GPIO_NUM_19)
+#define I2C_BUS1_SDA_IO               (GPIO_NUM_18)
+// Sensörlerin hattı ve adresi açılışta taranarak bulunur, SPI'daki ADXL345 bu hattın görevinde okunur
+#define ADXL345_I2C_PORT              ( I2C_NUM_1 )
 #define I2C_MASTER_FREQ_HZ            (   400000  )
-#define I2C_MASTER_TIMEOUT_MS         (     1000  )
-#define I2C_MASTER_TX_BUF_DISABLE     (      0    )                     
-#define I2C_MASTER_RX_BUF_DISABLE     (      0    )
+#define I2C_BMX280_MAX_FREQ_HZ        (  1000000  )
+#define I2C_ADXL345_MAX_FREQ_HZ       (   400000  )
+#define I2C_MAX_ERR_PERMILLE          (      50   )
+#define I2C_MASTER_TIMEOUT_MS         (       20  )
 #define DATA_BUFFER_SIZE              (     20    )
+// Hat görevleri: okuma periyodu ve çekirdek, tskNO_AFFINITY çekirdek seçmez
+#define I2C_BUS0_PERIOD_MS            (     1000  )
+// BMx280 tek seferlik ölçüm: sensörler ölçümler arasında uykuda kalır, hattaki tüm BMx280'ler
+// birlikte tetiklenip tek toplu işlemle okunur, 0 sürekli (normal) mod
+#define BMX280_USE_FORCED             (        1  )
+#define BMX280_PERIOD_MS              (     1000  )   // Tek seferlik ölçüm periyodu, hat periyodundan bağımsız
+#define BMX280_BUSY_RETRY_US          (     2000  )   // Ölçüm bitmemişse yeniden okuma aralığı
+#define BMX280_BUSY_RETRIES           (        3  )
+// Toplu okuma durum yazmacından başlar: 0xF3 durum, 0xF4..0xF6 ctrl_meas, config, ayrılmış
+#define BMX280_STATUS_OFFSET          (REGISTER_PRESS_MSB_ADDR - REGISTER_STATUS_ADDR)
+// ADXL345 SPI modu: 5 MHz SPI ile 3200 Hz veri hızı, I2C1 hattı kullanılmaz
+#define ADXL345_USE_SPI               (        0  )
+#define ADXL345_SPI_HOST              ( SPI2_HOST )
+#define ADXL345_SPI_SCLK_IO           (GPIO_NUM_14)
+#define ADXL345_SPI_MOSI_IO           (GPIO_NUM_13)
+#define ADXL345_SPI_MISO_IO           (GPIO_NUM_27)
+#define ADXL345_SPI_CS_IO             (GPIO_NUM_26)
+#if ADXL345_USE_SPI
+#define ADXL345_SAMPLE_RATE_HZ        (     3200  )
+#define I2C_BUS1_PERIOD_MS            (       10  )   // Kesmesiz okumada tick çözünürlüğü, FIFO 10 ms'de dolar
+#define ADXL345_IRQ_TIMEOUT_MS        (       10  )   // Kaçan kesmede FIFO dolmadan okuma
+#define VIBFEAT_WINDOW_SAMPLES        (     1600  )   // 0,5 s'lik zaman uzayı özellik penceresi
+#else
+#define ADXL345_SAMPLE_RATE_HZ        (      400  )
+#define I2C_BUS1_PERIOD_MS            (       40  )   // 400 Hz'de 16 örnek, FIFO 80 ms'de dolar
+#define ADXL345_IRQ_TIMEOUT_MS        (       80  )   // Kaçan kesmede FIFO dolmadan okuma
+#define VIBFEAT_WINDOW_SAMPLES        (      400  )   // 1 s'lik zaman uzayı özellik penceresi
+#endif
+#define ADXL345_WATERMARK             (       16  )
+// ADXL345 kesme modu: INT1 watermark/overrun ile görev uyandırılır
+#define ADXL345_USE_IRQ               (        1  )
+#define ADXL345_INT1_IO               (GPIO_NUM_4)
+#define ADXL345_IDLE_TIMEOUT_MS       (     1000  )   // Hareketsizken yalnızca olay kesmeleri beklenir
+// ADXL345 hareket kapısı: hareketsizlikte uyku, harekette veri akışı
+#define ADXL345_ACT_MG                (      250  )
+#define ADXL345_INACT_MG              (      125  )
+#define ADXL345_INACT_TIME_S          (       10  )
+#define ADXL345_TAP_MG                (     3000  )
+#define ADXL345_TAP_DUR_US            (    10000  )
+#define ADXL345_FREEFALL_MG           (      375  )
+#define ADXL345_FREEFALL_MS           (      100  )
+// Titreşim spektrumu: 512 örneklik blok, 400 Hz'de 1.28 s'de bir özellik
+#define SPECTRUM_BLOCK_SIZE           (SPECTRUM_SIZE_512)
+#define I2C_BUS_TASK_STACK            (     3072  )
+#define I2C_BUS_TASK_PRIORITY         ( tskIDLE_PRIORITY + 2 )
+#if CONFIG_FREERTOS_UNICORE
+#define I2C_BUS0_TASK_CORE            ( tskNO_AFFINITY )
+#define I2C_BUS1_TASK_CORE            ( tskNO_AFFINITY )
+#else
+#define I2C_BUS0_TASK_CORE            (        0  )
+#define I2C_BUS1_TASK_CORE            (        1  )
+#endif
+#define SENSOR_INVALID                (INT16_MIN)   // Okunamayan örnek işareti
+#define TEMP_MEDIAN_WINDOW            (        5  )   // Sıcaklık medyan filtresi penceresi, tek sayı
 
 char *TAG = "BLE-Ugur";
 uint8_t ble_addr_type;
@@ -36,25 +98,417 @@ static const char *BME280 = "bme280 sicaklik";
 static const char *BMP280 = "bmp280 sicaklik";
 static const char *ADXL = "x axis";
 void ble_app_advertise(void);
-static esp_err_t  i2c_master_init(void);
-int16_t x_axis;
 int16_t bme280_temp;
 int16_t bmp280_temp;
+// Son okuma başarılı mı, geçersiz örnekler filtreye verilmez
+bool x_axisValid;
+bool bme280_tempValid;
+bool bme280_dataValid;          // Basınç ve nem ölçümü atlanmadı
+BME280_data_t bme280_data;      // bme280_dataValid ile birlikte bme280Lock altında yazılır ve okunur
+static portMUX_TYPE bme280Lock = portMUX_INITIALIZER_UNLOCKED;
+bool bmp280_tempValid;
 
-int16_t x_axisFiltered[DATA_BUFFER_SIZE];
 int16_t bme280_tempFiltered[DATA_BUFFER_SIZE];
 int16_t bmp280_tempFiltered[DATA_BUFFER_SIZE];
-int16_t blePacket[3];
+int16_t blePacket[2];
+
+// Sensör tablosundaki sıralar
+enum
+{
+    SENSOR_BME280,
+    SENSOR_BMP280,
+    SENSOR_ADXL345,
+    SENSOR_COUNT
+};
+
+// Sensör okuma bloğu, kimlik registerı, taramadaki parça türü ve çözümleme fonksiyonu
+// drain tanımlı sensörler toplu okumaya girmez, kendi okuma fonksiyonlarıyla okunur
+typedef struct
+{
+    I2CBUS_batchRead_t read;
+    I2CBUS_probe_t     probe;
+    SENSORSCAN_part_e  part;        // SENSORSCAN_PART_NONE: taranmaz, her zaman var
+    esp_err_t        (*trigger)(uint32_t *waitUs);  // Ölçümü başlatır, sonuç sonraki bir turda okunur, NULL olabilir
+    bool             (*busy)(void);                 // Okunan durum yazmacında ölçüm sürüyor, trigger ile birlikte
+    esp_err_t        (*drain)(void);
+    void             (*decode)(bool valid);
+} sensor_slot_t;
+
+// Hat başına edinim görevi bağlamı
+typedef struct
+{
+    I2CBUS_busConfig_t   conf;
+    BaseType_t           core;
+    bool                 irqDriven;   // Periyot yerine kesme bildirimi beklenir
+    TaskHandle_t         task;
+    uint32_t             periodMs;
+    size_t               count;
+    const sensor_slot_t *slots[SENSOR_COUNT];
+    I2CBUS_probe_t       probes[SENSOR_COUNT];
+    // Tek seferlik ölçümler: tetikleme ve okuma ayrı turlarda, ADXL345 boşaltması beklemez
+    bool                 forced;                   // Hatta tetiklenen sensör var
+    int64_t              forcedTriggerUs;          // Sonraki tetikleme zamanı (esp_timer)
+    int64_t              forcedReadyUs;            // Dönüşümün bittiği en erken zaman, okunacak ölçüm yokken 0
+    uint8_t              forcedRetries;
+    bool                 pending[SENSOR_COUNT];    // Tetiklendi, okunmayı bekliyor
+} sensor_bus_t;
+
+// Port ve adres taramada bulunan parçadan atanır
+static I2CBUS_device_t bme280Dev = {
+    .clkSpeed  = I2C_BMX280_MAX_FREQ_HZ,
+    .timeoutMs = I2C_MASTER_TIMEOUT_MS,
+};
+
+static I2CBUS_device_t bmp280Dev = {
+    .clkSpeed  = I2C_BMX280_MAX_FREQ_HZ,
+    .timeoutMs = I2C_MASTER_TIMEOUT_MS,
+};
+
+static I2CBUS_device_t adxl345Dev = {
+    .port      = ADXL345_I2C_PORT,
+    .clkSpeed  = I2C_ADXL345_MAX_FREQ_HZ,
+    .timeoutMs = I2C_MASTER_TIMEOUT_MS,
+};
+
+#if ADXL345_USE_SPI
+static const ADXL_spiConfig_t adxl345Spi = {
+    .host     = ADXL345_SPI_HOST,
+    .mosiIo   = ADXL345_SPI_MOSI_IO,
+    .misoIo   = ADXL345_SPI_MISO_IO,
+    .sclkIo   = ADXL345_SPI_SCLK_IO,
+    .csIo     = ADXL345_SPI_CS_IO,
+    .clkSpeed = ADXL345_SPI_CLK_MAX,
+};
+#endif
+
+static uint8_t bme280Burst[BMX280_STATUS_OFFSET + BME280_BURST_READ_SIZE];
+static uint8_t bmp280Burst[BMX280_STATUS_OFFSET + BMP280_BURST_READ_SIZE];
+static BME280_rawData_t bme280Raw;
+static BME280_rawData_t bmp280Raw;
+// Her sensörün kendi BMx280 bağlamı, nem desteği çip kimliğinden belirlenir
+static BMX280_t bme280Ctx;
+static BMX280_t bmp280Ctx;
+static const BMX280_config_t bmx280Config = {
+    .mode      = BMX280_USE_FORCED ? BME280_SLEEP_MODE : BME280_NORMAL_MODE,
+    .tempOver  = TEMP_OVERSAMPLING_X2,
+    .pressOver = PRESS_OVERSAMPLING_X16,
+    .humOver   = HUM_OVERSAMPLING_X1,
+    .filter    = BME280_FILTER_X16,
+    .standby   = BME280_STANDBY_5,
+};
+static ADXL_sample_t adxl345Block[ADXL345_FIFO_ENTRIES_MAX];
+static size_t adxl345BlockCount;
+static ADXL_intsource_t adxl345IntSource;
+// Hareket varken örnekler yayınlanır, hareketsizlikte akış kesmeleri kapatılır
+static bool adxl345Moving = true;
+static ADXL_intenable_t adxl345IntEnable;
+static ADXL_intmap_t adxl345IntMap;   // Tüm kaynaklar INT1
+
+static const ADXL_motionConfig_t adxl345Motion = {
+    .actThresh_u8   = (uint8_t)(ADXL345_ACT_MG / ADXL345_THRESH_MG_LSB),
+    .inactThresh_u8 = (uint8_t)(ADXL345_INACT_MG / ADXL345_THRESH_MG_LSB),
+    .inactTime_u8   = ADXL345_INACT_TIME_S,
+    // Üç eksen, AC kuplaj: yerçekimi ve montaj açısı eşiği etkilemez
+    .ctl            = { .u8 = 0xFF },
+    .autoSleep_u1   = 1,
+    .wakeup_u2      = 0,   // Uykuda 8 Hz
+};
+
+static const ADXL_tapConfig_t adxl345Tap = {
+    .thresh_u8 = (uint8_t)(ADXL345_TAP_MG / ADXL345_THRESH_MG_LSB),
+    .dur_u8    = ADXL345_TAP_DUR_US / 625,
+    .latent_u8 = 0,        // Çift vuruş kapalı
+    .window_u8 = 0,
+    .axes      = { .u8 = 0x07 },
+};
+
+// Spektrum bantları (Hz): yapısal, dengesizlik, yatak ve üst bant
+static const SPECTRUM_config_t spectrumConfig = {
+    .size             = SPECTRUM_BLOCK_SIZE,
+    .sampleRateHz_u16 = ADXL345_SAMPLE_RATE_HZ,
+    .bandCount_u8     = 4,
+    .bandEdgesHz_u16  = { 2, 10, 50, 100, 200 },
+};
+// BLE ile ham ivme yerine eksen başına spektrum ve zaman uzayı özellikleri yayınlanır
+static SPECTRUM_features_t spectrumPacket[SPECTRUM_AXES];
+static VIBFEAT_window_t vibWindow;
+static VIBFEAT_features_t vibPacket[VIBFEAT_AXES];
+static portMUX_TYPE featureLock = portMUX_INITIALIZER_UNLOCKED;
+// Vuruş ve serbest düşme olayları açılıştan beri sayılır, BLE paketinde featureLock altında yayınlanır
+typedef struct
+{
+    uint16_t taps;
+    uint16_t freeFalls;
+} adxl345_event_count_t;
+static adxl345_event_count_t adxl345EventCount;
+// Her sıcaklık kanalının kendi medyan filtresi, sıfırın altındaki değerler işaretli tutulur
+static MEDFILT_t bme280TempFilter;
+static MEDFILT_t bmp280TempFilter;
+static uint32_t bme280TempStorage[MEDFILT_STORAGE_WORDS(TEMP_MEDIAN_WINDOW)];
+static uint32_t bmp280TempStorage[MEDFILT_STORAGE_WORDS(TEMP_MEDIAN_WINDOW)];
+
+static const ADXL_freefallConfig_t adxl345FreeFall = {
+    .thresh_u8 = (uint8_t)(ADXL345_FREEFALL_MG / ADXL345_THRESH_MG_LSB),
+    .time_u8   = ADXL345_FREEFALL_MS / 5,
+};
+
+// Okunan blokların çözümlenmesi, ilgili hat görevinde çalışır
+// Tek seferlik ölçümü tetikleme, sonuç dönüşüm süresi sonra toplu okumayla alınır
+static esp_err_t bme280_trigger(uint32_t *waitUs)
+{
+    *waitUs = BMX280_MeasureTimeUs(&bme280Ctx);
+    return BMX280_SetMode(&bme280Ctx, BME280_FORCED_MODE);
+}
+
+static esp_err_t bmp280_trigger(uint32_t *waitUs)
+{
+    *waitUs = BMX280_MeasureTimeUs(&bmp280Ctx);
+    return BMX280_SetMode(&bmp280Ctx, BME280_FORCED_MODE);
+}
+
+// Durum yazmacı veri yazmaçlarıyla aynı işlemde okunur
+static bool bme280_busy(void)
+{
+    BME280_registerStatus_t status = { .u8 = bme280Burst[0] };
+
+    return status.bit.measuring_u1;
+}
 
+static bool bmp280_busy(void)
+{
+    BMP280_registerStatus_t status = { .u8 = bmp280Burst[0] };
+
+    return status.bit.measuring_u1;
+}
+
+static void bme280_decode(bool valid)
+{
+    BME280_data_t data;
+    bool dataValid = false;
+
+    if (valid)
+    {
+        BMX280_DecodeRawData(&bme280Ctx, &bme280Burst[BMX280_STATUS_OFFSET], &bme280Raw);
+        // Basınç ve nem aynı anlık görüntünün t_fine değerini kullanır
+        dataValid = (BMX280_Compensate(&bme280Ctx, &bme280Raw, &data) == ESP_OK);
+        bme280_temp = data.temp_s32 / 100;
+    }
+    portENTER_CRITICAL(&bme280Lock);
+    if (valid)
+    {
+        bme280_data = data;
+    }
+    bme280_dataValid = dataValid;
+    portEXIT_CRITICAL(&bme280Lock);
+    bme280_tempValid = valid;
+}
+
+static void bmp280_decode(bool valid)
+{
+    BME280_data_t data;
+
+    if (valid)
+    {
+        BMX280_DecodeRawData(&bmp280Ctx, &bmp280Burst[BMX280_STATUS_OFFSET], &bmp280Raw);
+        BMX280_Compensate(&bmp280Ctx, &bmp280Raw, &data);
+        bmp280_temp = data.temp_s32 / 100;
+    }
+    bmp280_tempValid = valid;
+}
+
+// Hareket durumuna göre watermark/overrun kesmelerini açma ya da kapatma
+static void adxl345_stream(bool on)
+{
+    adxl345IntEnable.bit.watermark  = on;
+    adxl345IntEnable.bit.overrun_u1 = on;
+    if (ADXL345_ConfigInterrupts(adxl345IntEnable, adxl345IntMap) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "adxl345 interrupt enable failed");
+    }
+}
+
+// INT_SOURCE olayları, okuma ile temizlenmiş olarak gelir
+static void adxl345_events(ADXL_intsource_t source)
+{
+    if (source.bit.inactivity_u1 && !source.bit.activity_u1 && adxl345Moving)
+    {
+        adxl345Moving = false;
+        adxl345_stream(false);
+        ESP_LOGI(ADXL, "hareketsiz, uyku");
+    }
+    if (source.bit.activity_u1 && !adxl345Moving)
+    {
+        adxl345Moving = true;
+        adxl345_stream(true);
+        // Bu okumadaki FIFO uyku hızında doldu: taşma durumu temizlenir, blok yeni pencereye girmez
+        adxl345IntSource.bit.overrun_u1 = 0;
+        adxl345BlockCount = 0;
+        SPECTRUM_Reset();
+        VIBFEAT_Reset(&vibWindow);
+        ESP_LOGI(ADXL, "hareket algilandi");
+    }
+    if (source.bit.singleTap_u1 || source.bit.freeAll_u1)
+    {
+        portENTER_CRITICAL(&featureLock);
+        adxl345EventCount.taps += source.bit.singleTap_u1;
+        adxl345EventCount.freeFalls += source.bit.freeAll_u1;
+        portEXIT_CRITICAL(&featureLock);
+    }
+    if (source.bit.singleTap_u1)
+    {
+        ESP_LOGI(ADXL, "vurus");
+    }
+    if (source.bit.freeAll_u1)
+    {
+        ESP_LOGW(ADXL, "serbest dusme");
+    }
+}
+
+// INT_SOURCE'a göre tek örnek ya da FIFO'da biriken tüm örnekleri okuma
+static esp_err_t adxl345_drain(void)
+{
+    esp_err_t err;
+
+    err = ADXL345_Service(adxl345Block, ADXL345_FIFO_ENTRIES_MAX, &adxl345BlockCount, &adxl345IntSource);
+    if (err == ESP_OK)
+    {
+        adxl345_events(adxl345IntSource);
+    }
+    return err;
+}
+
+// Yayınlanan zaman uzayı özelliklerini güncelleme
+static void adxl345_publish_vib(const VIBFEAT_features_t *features)
+{
+    portENTER_CRITICAL(&featureLock);
+    memcpy(vibPacket, features, sizeof(vibPacket));
+    portEXIT_CRITICAL(&featureLock);
+}
+
+// FIFO bloklarını spektrum bloğuna ve özellik penceresine ekleme, dolunca özellikleri çıkarma
+static void adxl345_features(void)
+{
+    SPECTRUM_features_t spectrum[SPECTRUM_AXES];
+    VIBFEAT_features_t  vib[VIBFEAT_AXES];
+    size_t used = 0;
+
+    // Taşmada örnek kaybı olur, yarım blok atılır
+    if (adxl345IntSource.bit.overrun_u1)
+    {
+        SPECTRUM_Reset();
+        VIBFEAT_Reset(&vibWindow);
+    }
+    while (used < adxl345BlockCount)
+    {
+        used += SPECTRUM_Feed(&adxl345Block[used].x_s16, adxl345BlockCount - used);
+        if (SPECTRUM_Process(spectrum) == ESP_OK)
+        {
+            portENTER_CRITICAL(&featureLock);
+            memcpy(spectrumPacket, spectrum, sizeof(spectrumPacket));
+            portEXIT_CRITICAL(&featureLock);
+        }
+    }
+    used = 0;
+    while (used < adxl345BlockCount)
+    {
+        used += VIBFEAT_Feed(&vibWindow, &adxl345Block[used].x_s16, adxl345BlockCount - used);
+        if (VIBFEAT_Process(&vibWindow, vib) == ESP_OK)
+        {
+            adxl345_publish_vib(vib);
+        }
+    }
+}
+
+// Hareketsizken okunan örnekler yayınlanmaz
+static void adxl345_decode(bool valid)
+{
+    // Okunamayan sensörde ortalama SENSOR_INVALID, hareketsizlikte tüm özellikler sıfır yayınlanır
+    VIBFEAT_features_t idle[VIBFEAT_AXES] = { 0 };
+
+    if (valid && adxl345Moving && adxl345BlockCount != 0)
+    {
+        x_axisValid = true;
+        adxl345_features();
+    }
+    else if (!valid || !adxl345Moving)
+    {
+        if (!valid)
+        {
+            for (size_t i = 0; i < VIBFEAT_AXES; i++)
+            {
+                idle[i].mean_s16 = SENSOR_INVALID;
+            }
+        }
+        if (x_axisValid || !valid)
+        {
+            adxl345_publish_vib(idle);
+        }
+        x_axisValid = false;
+        SPECTRUM_Reset();
+        VIBFEAT_Reset(&vibWindow);
+    }
+}
+
+// Sensör tablosu, her sensör cihazının port alanındaki hatta okunur
+static const sensor_slot_t sensorSlots[SENSOR_COUNT] = {
+    [SENSOR_BME280]  = { { .dev = &bme280Dev, .reg = REGISTER_STATUS_ADDR, .data = bme280Burst, .len = sizeof(bme280Burst) },
+                         { &bme280Dev,  REGISTER_ID_ADDR,    BME280_CHIP_ID }, SENSORSCAN_PART_BME280,
+                         BMX280_USE_FORCED ? bme280_trigger : NULL, bme280_busy, NULL, bme280_decode },
+    [SENSOR_BMP280]  = { { .dev = &bmp280Dev, .reg = BMP280_STATUS_ADDR,   .data = bmp280Burst, .len = sizeof(bmp280Burst) },
+                         { &bmp280Dev,  BMP280_ID_ADDR,      BMP280_CHIP_ID }, SENSORSCAN_PART_BMP280,
+                         BMX280_USE_FORCED ? bmp280_trigger : NULL, bmp280_busy, NULL, bmp280_decode },
+    [SENSOR_ADXL345] = { { .dev = &adxl345Dev },
+                         { &adxl345Dev, REGISTER_DEVID_ADDR, ADXL345_DEVID  },
+                         ADXL345_USE_SPI ? SENSORSCAN_PART_NONE : SENSORSCAN_PART_ADXL345,
+                         NULL, NULL, adxl345_drain, adxl345_decode },
+};
+// Açılış taramasının sonucu ve tablodaki hangi sensörlerin bulunduğu
+static SENSORSCAN_result_t sensorScan;
+static bool sensorFound[SENSOR_COUNT];
+
+static sensor_bus_t sensorBuses[I2C_NUM_MAX] = {
+    {
+        .conf     = { .port = I2C_NUM_0, .sdaIo = I2C_BUS0_SDA_IO, .sclIo = I2C_BUS0_SCL_IO, .clkSpeed = I2C_MASTER_FREQ_HZ },
+        .core     = I2C_BUS0_TASK_CORE,
+        .periodMs = I2C_BUS0_PERIOD_MS,
+    },
+    {
+        .conf     = { .port = I2C_NUM_1, .sdaIo = I2C_BUS1_SDA_IO, .sclIo = I2C_BUS1_SCL_IO, .clkSpeed = I2C_MASTER_FREQ_HZ },
+        .core     = I2C_BUS1_TASK_CORE,
+        .periodMs = I2C_BUS1_PERIOD_MS,
+    },
+};
 
 // Karakteristik tanımlama
 #define SENSOR_DATA_UUID 0x3636
+#define SPECTRUM_DATA_UUID 0x3637
 static uint8_t sensor_data_chr_value;
 
 // Callback fonksiyonu
 static int sensor_data_read(uint16_t con_handle, uint16_t attr_handle, struct ble_gatt_access_ctxt *ctxt, void *arg)
 {
+    VIBFEAT_features_t vib[VIBFEAT_AXES];
+    adxl345_event_count_t events;
+
+    portENTER_CRITICAL(&featureLock);
+    memcpy(vib, vibPacket, sizeof(vib));
+    events = adxl345EventCount;
+    portEXIT_CRITICAL(&featureLock);
     os_mbuf_append(ctxt->om, &blePacket, sizeof(blePacket));
+    os_mbuf_append(ctxt->om, vib, sizeof(vib));
+    // İstemci iki okuma arasındaki farktan yeni olayları görür
+    os_mbuf_append(ctxt->om, &events, sizeof(events));
+    return 0;
+}
+
+static int spectrum_data_read(uint16_t con_handle, uint16_t attr_handle, struct ble_gatt_access_ctxt *ctxt, void *arg)
+{
+    SPECTRUM_features_t packet[SPECTRUM_AXES];
+
+    portENTER_CRITICAL(&featureLock);
+    memcpy(packet, spectrumPacket, sizeof(packet));
+    portEXIT_CRITICAL(&featureLock);
+    os_mbuf_append(ctxt->om, packet, sizeof(packet));
     return 0;
 }
 
@@ -69,6 +523,11 @@ static const struct ble_gatt_svc_def gatt_svcs[] = {
                 .flags = BLE_GATT_CHR_F_READ,
                 .access_cb = sensor_data_read,
             },
+            {
+                .uuid = BLE_UUID16_DECLARE(SPECTRUM_DATA_UUID),
+                .flags = BLE_GATT_CHR_F_READ,
+                .access_cb = spectrum_data_read,
+            },
             {0},
         },
     },
@@ -138,15 +597,340 @@ void host_task(void *param)
     nimble_port_run(); // This function will return only when nimble_port_stop() is executed
 }
 
+// Hatlardaki sensörleri tarama ve bulunan parçaları tablodaki sensörlere atama
+static void sensors_discover(void)
+{
+    i2c_port_t ports[I2C_NUM_MAX];
+    size_t portCount = 0;
+
+    for (int port = 0; port < I2C_NUM_MAX; port++)
+    {
+        if (I2CBUS_Init(&sensorBuses[port].conf) == ESP_OK)
+        {
+            ports[portCount++] = port;
+        }
+        else
+        {
+            ESP_LOGW(TAG, "i2c%d setup failed", port);
+        }
+    }
+    // Hatlar paralel taranır, her açılışta tüm adresler okunur, NVS yalnızca sonuç değişince yazılır
+    ESP_ERROR_CHECK(SENSORSCAN_Discover(ports, portCount, &sensorScan));
+    for (size_t i = 0; i < sensorScan.count_u8; i++)
+    {
+        ESP_LOGI(TAG, "i2c%u 0x%02x: parca %u", sensorScan.entries[i].port_u8, sensorScan.entries[i].addr_u8,
+                 sensorScan.entries[i].part_u8);
+    }
+    ESP_LOGI(TAG, "%u sensor bulundu%s", sensorScan.count_u8, sensorScan.fromCache ? " (NVS ile ayni)" : "");
+    for (size_t i = 0; i < SENSOR_COUNT; i++)
+    {
+        sensorFound[i] = (sensorSlots[i].part == SENSORSCAN_PART_NONE) ||
+                         (SENSORSCAN_Take(&sensorScan, sensorSlots[i].part, sensorSlots[i].probe.dev) == ESP_OK);
+    }
+}
+
+// Hatta bulunan sensörleri toplama ve saat hızını seçme, sürücü taramada kurulur
+static esp_err_t sensor_bus_setup(sensor_bus_t *bus)
+{
+    size_t probeCount = 0;
+
+    bus->count = 0;
+    bus->forced = false;
+    for (size_t i = 0; i < SENSOR_COUNT; i++)
+    {
+        if (sensorFound[i] && sensorSlots[i].read.dev->port == bus->conf.port)
+        {
+            bus->slots[bus->count++] = &sensorSlots[i];
+            // SPI'daki ADXL345 hattın görevinde boşaltılır ama I2C saat taramasına girmez
+            if (sensorSlots[i].part != SENSORSCAN_PART_NONE)
+            {
+                bus->probes[probeCount++] = sensorSlots[i].probe;
+            }
+            if (sensorSlots[i].trigger != NULL)
+            {
+                bus->forced = true;
+            }
+        }
+    }
+    if (probeCount == 0)
+    {
+        return ESP_OK;
+    }
+    // Hatasız en yüksek saat hızını seçme, hata oranı artarsa hız düşürülür
+    if (I2CBUS_ProbeClock(bus->conf.port, bus->probes, probeCount) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "i2c%d clock probe failed", bus->conf.port);
+    }
+    ESP_LOGI(TAG, "i2c%d clock %lu Hz", bus->conf.port, (unsigned long)I2CBUS_GetClock(bus->conf.port));
+    I2CBUS_SetAdaptive(bus->conf.port, I2C_MAX_ERR_PERMILLE);
+    return ESP_OK;
+}
+
+// Bir sonraki tek seferlik ölçüm olayına kadar bekleme, en fazla maxTicks
+static TickType_t sensor_bus_wait(const sensor_bus_t *bus, TickType_t maxTicks)
+{
+    const int64_t tickUs = portTICK_PERIOD_MS * 1000;
+    int64_t untilUs;
+    TickType_t ticks;
+
+    if (!bus->forced)
+    {
+        return maxTicks;
+    }
+    untilUs = ((bus->forcedReadyUs != 0) ? bus->forcedReadyUs : bus->forcedTriggerUs) - esp_timer_get_time();
+    if (untilUs <= 0)
+    {
+        return 0;
+    }
+    // Tick sınırında erken uyanmamak için yukarı yuvarlanır
+    ticks = (TickType_t)((untilUs + tickUs - 1) / tickUs);
+    return (ticks < maxTicks) ? ticks : maxTicks;
+}
+
+// Hattaki tek seferlik ölçümleri birlikte başlatma, sonuçlar dönüşüm süresi geçince okunur
+static void sensor_bus_trigger(sensor_bus_t *bus, int64_t now)
+{
+    uint32_t waitUs = 0;
+    uint32_t slotWaitUs;
+
+    for (size_t i = 0; i < bus->count; i++)
+    {
+        if (bus->slots[i]->trigger == NULL)
+        {
+            continue;
+        }
+        if (bus->slots[i]->trigger(&slotWaitUs) == ESP_OK)
+        {
+            bus->pending[i] = true;
+            waitUs = (slotWaitUs > waitUs) ? slotWaitUs : waitUs;
+        }
+        else
+        {
+            // Tetiklenemeyen sensörün yazmaçlarında önceki ölçüm durur
+            bus->slots[i]->decode(false);
+        }
+    }
+    bus->forcedReadyUs = now + waitUs;
+    bus->forcedRetries = 0;
+    // Geride kalınırsa kaçan tetiklemeler toplanmaz
+    bus->forcedTriggerUs += BMX280_PERIOD_MS * 1000LL;
+    if (bus->forcedTriggerUs <= now)
+    {
+        bus->forcedTriggerUs = now + BMX280_PERIOD_MS * 1000LL;
+    }
+}
+
+// Hat başına edinim görevi: hattaki sensörleri tek I2C işlemiyle okuma
+static void sensor_bus_task(void *param)
+{
+    sensor_bus_t *bus = param;
+    const TickType_t period = pdMS_TO_TICKS(bus->periodMs);
+    TickType_t lastWake = xTaskGetTickCount() - period;   // İlk tur hemen okur
+    TickType_t elapsed;
+    esp_err_t lastErr = ESP_OK;
+    esp_err_t err;
+    esp_err_t slotErr;
+    I2CBUS_batchRead_t reads[SENSOR_COUNT];
+    size_t readSlot[SENSOR_COUNT];
+    size_t readCount;
+    size_t i;
+    bool periodDue;
+    bool forcedDue;
+    bool stillBusy;
+    int64_t now;
+
+    bus->forcedTriggerUs = esp_timer_get_time();
+    while (1)
+    {
+        // Diğer görevlerin kuyruğa eklediği işlemler hattın tek sahibi olan bu görevde çalışır
+        I2CASYNC_Service(bus->conf.port);
+        now = esp_timer_get_time();
+        forcedDue = bus->forced && (bus->forcedReadyUs != 0 ? now >= bus->forcedReadyUs : now >= bus->forcedTriggerUs);
+        periodDue = true;
+        if (!bus->irqDriven)
+        {
+            // Kuyruk bildirimi bekleyişi erken bitirir, okuma periyodu korunur
+            elapsed = xTaskGetTickCount() - lastWake;
+            periodDue = (elapsed >= period);
+            if (!periodDue && !forcedDue)
+            {
+                ulTaskNotifyTake(pdTRUE, sensor_bus_wait(bus, period - elapsed));
+                continue;
+            }
+            if (periodDue)
+            {
+                lastWake += period;
+            }
+        }
+        // Dönüşümü bitmiş tek seferlik ölçümler ve periyodu gelen sürekli mod sensörleri toplu okunur
+        readCount = 0;
+        for (i = 0; i < bus->count; i++)
+        {
+            if (bus->slots[i]->drain == NULL &&
+                (bus->slots[i]->trigger == NULL ? periodDue : (bus->pending[i] && now >= bus->forcedReadyUs)))
+            {
+                readSlot[readCount] = i;
+                reads[readCount++] = bus->slots[i]->read;
+            }
+        }
+        // Hatalı bloklar geçersiz işaretlenir, diğer sensörler etkilenmez
+        err = (readCount != 0) ? I2CBUS_BatchRead(reads, readCount) : ESP_OK;
+        stillBusy = false;
+        for (size_t r = 0; r < readCount; r++)
+        {
+            i = readSlot[r];
+            slotErr = reads[r].status;
+            if (bus->slots[i]->trigger != NULL)
+            {
+                // Ölçüm bitmediyse kısa süre sonra yeniden okunur, sonunda geçersiz sayılır
+                if (slotErr == ESP_OK && bus->slots[i]->busy())
+                {
+                    if (bus->forcedRetries < BMX280_BUSY_RETRIES)
+                    {
+                        stillBusy = true;
+                        continue;
+                    }
+                    slotErr = ESP_ERR_TIMEOUT;
+                }
+                bus->pending[i] = false;
+            }
+            if (err == ESP_OK)
+            {
+                err = slotErr;
+            }
+            bus->slots[i]->decode(slotErr == ESP_OK);
+        }
+        if (stillBusy)
+        {
+            bus->forcedRetries++;
+            bus->forcedReadyUs = now + BMX280_BUSY_RETRY_US;
+        }
+        else if (bus->forcedReadyUs != 0 && now >= bus->forcedReadyUs)
+        {
+            bus->forcedReadyUs = 0;
+        }
+        // Tetikleme okumadan sonra: aynı turda biten ölçüm yeniden başlatılabilir
+        if (bus->forced && bus->forcedReadyUs == 0 && now >= bus->forcedTriggerUs)
+        {
+            sensor_bus_trigger(bus, now);
+        }
+        // FIFO boşaltması dönüşüm beklemez
+        for (i = 0; periodDue && i < bus->count; i++)
+        {
+            if (bus->slots[i]->drain != NULL)
+            {
+                slotErr = bus->slots[i]->drain();
+                if (err == ESP_OK)
+                {
+                    err = slotErr;
+                }
+                bus->slots[i]->decode(slotErr == ESP_OK);
+            }
+        }
+        if (err != lastErr)
+        {
+            ESP_LOGW(TAG, "i2c%d batch read: %s", bus->conf.port, esp_err_to_name(err));
+            lastErr = err;
+        }
+        if (bus->irqDriven)
+        {
+            ulTaskNotifyTake(pdTRUE, sensor_bus_wait(bus, pdMS_TO_TICKS(adxl345Moving ? ADXL345_IRQ_TIMEOUT_MS
+                                                                                      : ADXL345_IDLE_TIMEOUT_MS)));
+        }
+    }
+}
+
+// I2C cihaz istatistiklerini yazdırma ve sıfırlama
+static void sensors_log_stats(const char *name, I2CBUS_device_t *dev)
+{
+    I2CBUS_stats_t stats;
+
+    I2CBUS_GetStats(dev, &stats);
+    I2CBUS_ResetStats(dev);
+    ESP_LOGI(TAG, "%s: %lu islem, %lu/%lu bayt, gecikme min/ort/max = %lu/%lu/%lu us, nack %lu, timeout %lu, hata %lu",
+             name, (unsigned long)stats.transCount, (unsigned long)stats.bytesOut, (unsigned long)stats.bytesIn,
+             (unsigned long)stats.minUs, (unsigned long)I2CBUS_AvgLatencyUs(&stats), (unsigned long)stats.maxUs,
+             (unsigned long)stats.nackCount, (unsigned long)stats.timeoutCount, (unsigned long)stats.busErrCount);
+    ESP_LOGI(TAG, "%s: tekrar %lu, hat temizleme %lu, karantina %lu, en uzun kurtarma %lu us",
+             name, (unsigned long)stats.retryCount, (unsigned long)stats.busClearCount,
+             (unsigned long)stats.quarantineCount, (unsigned long)stats.maxRecoverUs);
+}
+
 // Ana uygulama
 void app_main()
 {
-    i2c_master_init();
-    BME280_Init();
-    BMP280_Init();
-    ADXL345_Init();
+    // Sensör listesi NVS'te tutulur, taramadan önce başlatılır
+    nvs_flash_init();
+    sensors_discover();
+    for (int port = 0; port < I2C_NUM_MAX; port++)
+    {
+        ESP_ERROR_CHECK(sensor_bus_setup(&sensorBuses[port]));
+    }
+    if (sensorFound[SENSOR_BME280] && BMX280_Init(&bme280Ctx, &bme280Dev, &bmx280Config) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "bme280 setup failed");
+    }
+    if (sensorFound[SENSOR_BMP280] && BMX280_Init(&bmp280Ctx, &bmp280Dev, &bmx280Config) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "bmp280 setup failed");
+    }
+    ESP_ERROR_CHECK(SPECTRUM_Init(&spectrumConfig));
+    ESP_ERROR_CHECK(VIBFEAT_Init(&vibWindow, VIBFEAT_WINDOW_SAMPLES));
+    ESP_ERROR_CHECK(MEDFILT_Init(&bme280TempFilter, MEDFILT_TYPE_S16, bme280TempStorage, TEMP_MEDIAN_WINDOW));
+    ESP_ERROR_CHECK(MEDFILT_Init(&bmp280TempFilter, MEDFILT_TYPE_S16, bmp280TempStorage, TEMP_MEDIAN_WINDOW));
+    if (sensorFound[SENSOR_ADXL345])
+    {
+#if ADXL345_USE_SPI
+        if (ADXL345_InitSpi(&adxl345Spi) != ESP_OK || ADXL345_SetDataRate(DATARATE3200_BANDWIDTH1600) != ESP_OK)
+        {
+            ESP_LOGW(TAG, "adxl345 spi setup failed");
+        }
+#else
+        ADXL345_Init(&adxl345Dev);
+#endif
+        ADXL345_SetWatermark(ADXL345_WATERMARK);
+        // Olay bitleri yalnızca INT_ENABLE'da açıkken INT_SOURCE'a yazılır, periyodik okumada da gerekli
+        if (ADXL345_ConfigMotion(&adxl345Motion) != ESP_OK || ADXL345_ConfigTap(&adxl345Tap) != ESP_OK ||
+            ADXL345_ConfigFreeFall(&adxl345FreeFall) != ESP_OK)
+        {
+            ESP_LOGW(TAG, "adxl345 event setup failed");
+        }
+        // Yazmaç gölgesi ve adxl345IntEnable bundan sonra yalnızca hat görevinde değişir,
+        // bu yüzden tüm yapılandırma görevler oluşturulmadan önce biter
+        adxl345IntEnable.bit.watermark     = 1;
+        adxl345IntEnable.bit.overrun_u1    = 1;
+        adxl345IntEnable.bit.activity_u1   = 1;
+        adxl345IntEnable.bit.inactivity_u1 = 1;
+        adxl345IntEnable.bit.singleTap_u1  = 1;
+        adxl345IntEnable.bit.freeAll_u1    = 1;
+        if (ADXL345_ConfigInterrupts(adxl345IntEnable, adxl345IntMap) != ESP_OK)
+        {
+            ESP_LOGW(TAG, "adxl345 interrupt enable failed");
+        }
+    }
+    sensorBuses[adxl345Dev.port].irqDriven = ADXL345_USE_IRQ && sensorFound[SENSOR_ADXL345];
+    // Her hat kendi görevinde okunur, bir hattaki gecikme diğerini bekletmez
+    for (int port = 0; port < I2C_NUM_MAX; port++)
+    {
+        if (sensorBuses[port].count != 0)
+        {
+            xTaskCreatePinnedToCore(sensor_bus_task, "i2c_acq", I2C_BUS_TASK_STACK, &sensorBuses[port],
+                                    I2C_BUS_TASK_PRIORITY, &sensorBuses[port].task, sensorBuses[port].core);
+            // Diğer görevler hatta yalnızca bu kuyruk üzerinden erişir
+            if (I2CASYNC_Init(port, sensorBuses[port].task) != ESP_OK)
+            {
+                ESP_LOGW(TAG, "i2c%d transaction queue setup failed", port);
+            }
+        }
+    }
+    // Kesme kurulamazsa hat görevi periyodik okumaya döner
+    if (sensorBuses[adxl345Dev.port].irqDriven &&
+        ADXL345_AttachInterrupt(ADXL345_INT1_IO, sensorBuses[adxl345Dev.port].task) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "adxl345 interrupt setup failed, polling");
+        sensorBuses[adxl345Dev.port].irqDriven = false;
+    }
    
-    nvs_flash_init(); // NVS flash'ını başlatma
     nimble_port_init(); // Host yığını başlatma
     // Servisleri başlatma
     ble_svc_gap_device_name_set("BLE-Server");
@@ -159,101 +943,57 @@ void app_main()
     // Ana görevi başlatma
     nimble_port_freertos_init(host_task);  
     
+    VIBFEAT_features_t vibLog;
+    BME280_data_t dataLog;
+    bool dataLogValid;
     while (1)
     {
 
          for(int i=0; i<DATA_BUFFER_SIZE;i++){
             
-             bme280_temp =  BME280_CalculateTemp() /100;
-             bmp280_temp = BMP280_CalculateTemp() /100;
-             x_axis = ADXL345_XaxisCalculate();
-            bme280_tempFiltered[i] = bme280_median_filter(bme280_temp);
-            bmp280_tempFiltered[i] = bmp280_median_filter(bmp280_temp);
-            x_axisFiltered[i]      = adxl_median_filter(x_axis);
+            bme280_tempFiltered[i] = bme280_tempValid ? MEDFILT_PutS16(&bme280TempFilter, bme280_temp) : SENSOR_INVALID;
+            bmp280_tempFiltered[i] = bmp280_tempValid ? MEDFILT_PutS16(&bmp280TempFilter, bmp280_temp) : SENSOR_INVALID;
             blePacket[0] = bme280_tempFiltered[i] ;
             blePacket[1] = bmp280_tempFiltered[i] ;
-            blePacket[2] = x_axisFiltered[i]; 
 
             ESP_LOGI(BME280, "sicaklik bme280 = %x\n", bme280_tempFiltered[i]);
             ESP_LOGI(BMP280, "sicaklik bmep80 = %x\n", bmp280_tempFiltered[i] );
-            ESP_LOGI(ADXL, "x axis = %x\n",x_axisFiltered[i]  );
+            // Basınç ve nem aynı ölçümden gelir, hat görevi yazarken okunmaz
+            portENTER_CRITICAL(&bme280Lock);
+            dataLog = bme280_data;
+            dataLogValid = bme280_dataValid;
+            portEXIT_CRITICAL(&bme280Lock);
+            if (dataLogValid)
+            {
+                ESP_LOGI(BME280, "basinc = %lu Pa, nem = %lu.%02lu %%RH\n",
+                         (unsigned long)(dataLog.press_u32 / BME280_PRESS_Q8_ONE),
+                         (unsigned long)(dataLog.hum_u32 / BME280_HUM_Q10_ONE),
+                         (unsigned long)((dataLog.hum_u32 % BME280_HUM_Q10_ONE) * 100 / BME280_HUM_Q10_ONE));
+            }
+            // Paket hat görevinde yazılır, yarım güncellenmiş değer basılmaz
+            portENTER_CRITICAL(&featureLock);
+            vibLog = vibPacket[0];
+            portEXIT_CRITICAL(&featureLock);
+            ESP_LOGI(ADXL, "x axis rms = %u, p-p = %u, crest = %u/256, kurtosis = %u/256\n",
+                     vibLog.rms_u16, vibLog.peakToPeak_u16, vibLog.crestQ8_u16, vibLog.kurtosisQ8_u16);
              vTaskDelay(30000 / portTICK_PERIOD_MS);
          }
+
+         if (sensorFound[SENSOR_BME280])
+         {
+             sensors_log_stats("bme280", &bme280Dev);
+         }
+         if (sensorFound[SENSOR_BMP280])
+         {
+             sensors_log_stats("bmp280", &bmp280Dev);
+         }
+#if !ADXL345_USE_SPI
+         if (sensorFound[SENSOR_ADXL345])
+         {
+             sensors_log_stats("adxl345", &adxl345Dev);
+         }
+#endif
          
     }
 
 }
-
-static esp_err_t  i2c_master_init(void)
-{
-    int i2c_master_port = I2C_PORT_NUM_0;
-
-    i2c_config_t conf = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = I2C_MASTER_SDA_IO,
-        .scl_io_num = I2C_MASTER_SCL_IO,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = I2C_MASTER_FREQ_HZ,
-    };
-
-    i2c_param_config(i2c_master_port, &conf);
-
-    return i2c_driver_install(i2c_master_port, conf.mode, I2C_MASTER_RX_BUF_DISABLE, I2C_MASTER_TX_BUF_DISABLE, 0);
-}
-
-int16_t bme280_register_write(BME280_registerAddr_e reg_addr, uint8_t data){
-     
-     
-     int temp = 0;
-     uint8_t write_buf[2] ={reg_addr, data};
-
-     
-
-     i2c_master_write_to_device(I2C_PORT_NUM_0, BME280_SENSOR_ADDR, write_buf, sizeof(write_buf), I2C_MASTER_TIMEOUT_MS / portTICK_PERIOD_MS);
-
-     return temp;
-}
-
-int16_t bme280_register_read(BME280_registerAddr_e reg_addr, uint8_t *data, size_t len){
-  
-    i2c_master_write_read_device(I2C_PORT_NUM_0, BME280_SENSOR_ADDR,&reg_addr, 1, data, len, I2C_MASTER_TIMEOUT_MS / portTICK_PERIOD_MS);
-    
-
-      return 0;
-}
-
-int16_t adxl_register_read(ADXL_registeraddr_e reg_addr, uint8_t *data, size_t len){
-
-    i2c_master_write_read_device(I2C_PORT_NUM_0, ADXL345_SENSOR_ADDR,&reg_addr, 1, data, len, I2C_MASTER_TIMEOUT_MS / portTICK_PERIOD_MS);
-
-    return 0;
-}
-
-int16_t adxl_register_write(ADXL_registeraddr_e reg_addr, uint8_t data){
-     
-     
-     uint8_t write_buf[2] ={reg_addr, data};
-
-    i2c_master_write_to_device(I2C_PORT_NUM_0, ADXL345_SENSOR_ADDR, write_buf, sizeof(write_buf), I2C_MASTER_TIMEOUT_MS / portTICK_PERIOD_MS);
-
-    return 0;
-}
-
-int16_t bmp280_register_write(BMP280_registerAddr_e reg_addr, uint8_t data){
-     
-     int temp = 0;
-     uint8_t write_buf[2] ={reg_addr, data};
-
-
-     i2c_master_write_to_device(I2C_PORT_NUM_0, BMP280_SENSOR_ADDR, write_buf, sizeof(write_buf), I2C_MASTER_TIMEOUT_MS / portTICK_PERIOD_MS);
-
-     return temp;
-}
-
-int16_t bmp280_register_read(BMP280_registerAddr_e reg_addr, uint8_t *data, size_t len){
- 
-     i2c_master_write_read_device(I2C_PORT_NUM_0, BMP280_SENSOR_ADDR,&reg_addr, 1, data, len, I2C_MASTER_TIMEOUT_MS / portTICK_PERIOD_MS);
-     
-      return 0;
-}
\ No newline at end of file